@@ -9,6 +9,10 @@ namespace rtype::ecs {
 class SpectatorSystem;
 }
 
+namespace rtype::rendering {
+class SFMLRenderer;
+}
+
 namespace sf {
 class Font;
 }
@@ -82,6 +86,9 @@ class GameState : public IState {
     GameEngine::entity_t lagometer_entity_ = 0;
     void createDevMetrics(GameEngine::Registry& registry, float windowWidth);
 
+    // Kept across frames so its sprite batches reuse their vertex storage
+    std::shared_ptr<rtype::rendering::SFMLRenderer> sfml_renderer_;
+
     // Spectator mode
     std::shared_ptr<rtype::ecs::SpectatorSystem> spectator_system_;
 
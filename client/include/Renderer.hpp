@@ -9,6 +9,7 @@
 #include <vector>
 #include "net/MessageData.hpp"
 #include "AccessibilityManager.hpp"
+#include "SpriteBatch.hpp"
 
 namespace rtype::client {
 
@@ -126,6 +127,7 @@ class Renderer {
     sf::View view_;
     std::unordered_map<std::string, sf::Texture> textures_;
     std::unordered_map<uint32_t, Entity> entities_;
+    rtype::rendering::SpriteBatch entity_batch_;
     sf::Font font_;
     sf::Text score_text_;
     sf::Text lives_text_;
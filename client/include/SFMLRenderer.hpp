@@ -1,6 +1,7 @@
 #pragma once
 
 #include "interfaces/rendering/IRenderer.hpp"
+#include "SpriteBatch.hpp"
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <unordered_map>
@@ -8,6 +9,7 @@
 
 namespace rtype::rendering {
 
+/// @brief IRenderer drawing to an SFML window, sprites are batched per texture until flush() or display()
 class SFMLRenderer : public IRenderer {
   public:
     SFMLRenderer(sf::RenderWindow& window, std::unordered_map<std::string, sf::Texture>& textures);
@@ -16,6 +18,8 @@ class SFMLRenderer : public IRenderer {
 
     void draw_sprite(const RenderData& data) override;
 
+    void flush() override;
+
     void clear() override;
 
     void display() override;
@@ -31,6 +35,7 @@ class SFMLRenderer : public IRenderer {
 
     sf::RenderWindow& window_;
     std::unordered_map<std::string, sf::Texture>& textures_;
+    SpriteBatch batch_;
 };
 
 } // namespace rtype::rendering
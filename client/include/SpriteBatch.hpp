@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace rtype::rendering {
+
+/// @brief Collects sprites into one vertex array per texture and draws each array in a single call
+/// @details Batches are drawn in the order their texture first appeared since the last flush, and sprites keep their
+/// submission order inside a batch. Vertex storage is kept between frames, so a steady scene does not allocate.
+class SpriteBatch {
+  public:
+    /// @brief Queues a sprite, with its transform, texture rect and color baked into the vertices
+    void draw(const sf::Sprite& sprite);
+
+    /// @brief Queues an untextured rectangle filled with color
+    void draw_rect(const sf::FloatRect& rect, const sf::Color& color);
+
+    /// @brief Draws every queued batch to target and empties them
+    void flush(sf::RenderTarget& target);
+
+    /// @brief Draw calls issued by the last flush
+    std::size_t last_draw_calls() const {
+        return last_draw_calls_;
+    }
+
+  private:
+    struct Batch {
+        const sf::Texture* texture;
+        sf::VertexArray vertices{sf::Triangles};
+    };
+
+    sf::VertexArray& batch_for(const sf::Texture* texture);
+    static void append_quad(sf::VertexArray& vertices, const sf::Vector2f (&corners)[4],
+                            const sf::Vector2f (&tex_coords)[4], const sf::Color& color);
+
+    std::vector<Batch> batches_;
+    std::vector<std::size_t> order_;
+    std::size_t last_batch_ = 0;
+    std::size_t last_draw_calls_ = 0;
+};
+
+} // namespace rtype::rendering
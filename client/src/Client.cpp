@@ -2,6 +2,7 @@
 #include "net/ProtocolAdapter.hpp"
 #include "net/MessageSerializer.hpp"
 #include "GameConstants.hpp"
+#include "NetworkIdIndex.hpp"
 #include "components/NetworkId.hpp"
 #include "components/Position.hpp"
 #include "components/Velocity.hpp"
@@ -207,16 +208,13 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
                     rtype::constants::PLAYER_HEIGHT * rtype::constants::PLAYER_SCALE);
                 registry_.addComponent<rtype::ecs::component::Collidable>(
                     entity, rtype::ecs::component::CollisionLayer::Player);
-                registry_.addComponent<rtype::ecs::component::Tag>(entity, "Player");
+                registry_.addComponent<rtype::ecs::component::Tag>(entity, rtype::ecs::tags::Player);
                 registry_.addComponent<rtype::ecs::component::Lives>(entity, 3);
                 registry_.addComponent<rtype::ecs::component::Health>(entity, 100, 100);
                 registry_.addComponent<rtype::ecs::component::Score>(entity, 0);
                 registry_.addComponent<rtype::ecs::component::NetworkInterpolation>(entity, 100.0f, 100.0f, 0.0f, 0.0f);
-                drawable.animation_sequences["idle"] = {2};
-                drawable.animation_sequences["up"] = {2, 3, 4};
-                drawable.animation_sequences["down"] = {2, 1, 0};
-                drawable.current_state = "idle";
-                drawable.last_state = "idle";
+                drawable.clip = rtype::ecs::clips::ShipIdle;
+                drawable.last_clip = rtype::ecs::clips::ShipIdle;
                 drawable.animation_timer = 0.0f;
                 drawable.animation_speed = 0.1f;
                 drawable.current_sprite = 2;
@@ -229,16 +227,7 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
                 std::cout << "Player " << join_data.player_id << " has joined the game." << std::endl;
 
                 std::lock_guard<std::mutex> lock(registry_mutex_);
-                bool player_exists = false;
-                auto view = registry_.view<rtype::ecs::component::NetworkId>();
-                for (auto entity : view) {
-                    auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(
-                        static_cast<GameEngine::entity_t>(entity));
-                    if (net_id.id == join_data.player_id) {
-                        player_exists = true;
-                        break;
-                    }
-                }
+                bool player_exists = rtype::ecs::NetworkIdIndex::of(registry_).find(join_data.player_id).has_value();
 
                 if (!player_exists) {
                     auto entity = registry_.createEntity();
@@ -256,7 +245,7 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
                         rtype::constants::PLAYER_HEIGHT * rtype::constants::PLAYER_SCALE);
                     registry_.addComponent<rtype::ecs::component::Collidable>(
                         entity, rtype::ecs::component::CollisionLayer::Player);
-                    registry_.addComponent<rtype::ecs::component::Tag>(entity, "Player");
+                    registry_.addComponent<rtype::ecs::component::Tag>(entity, rtype::ecs::tags::Player);
                     registry_.addComponent<rtype::ecs::component::Lives>(entity, 3);
                     registry_.addComponent<rtype::ecs::component::Health>(entity, 100, 100);
 
@@ -267,11 +256,8 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
                                                                                             0.0f, 0.0f);
                     }
 
-                    drawable.animation_sequences["idle"] = {2};
-                    drawable.animation_sequences["up"] = {2, 3, 4};
-                    drawable.animation_sequences["down"] = {2, 1, 0};
-                    drawable.current_state = "idle";
-                    drawable.last_state = "idle";
+                    drawable.clip = rtype::ecs::clips::ShipIdle;
+                    drawable.last_clip = rtype::ecs::clips::ShipIdle;
                     drawable.animation_timer = 0.0f;
                     drawable.animation_speed = 0.1f;
                     drawable.current_sprite = 2;
@@ -336,24 +322,14 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
 
             {
                 std::lock_guard<std::mutex> lock(registry_mutex_);
-                auto view = registry_.view<rtype::ecs::component::NetworkId>();
-                for (auto entity : view) {
-                    auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(
-                        static_cast<GameEngine::entity_t>(entity));
-                    if (net_id.id == player_id_) {
-                        if (registry_.hasComponent<rtype::ecs::component::Lives>(
-                                static_cast<GameEngine::entity_t>(entity))) {
-                            auto& lives = registry_.getComponent<rtype::ecs::component::Lives>(
-                                static_cast<GameEngine::entity_t>(entity));
-                            lives.remaining = game_state_data.lives;
-                        }
-                        if (registry_.hasComponent<rtype::ecs::component::Score>(
-                                static_cast<GameEngine::entity_t>(entity))) {
-                            auto& score = registry_.getComponent<rtype::ecs::component::Score>(
-                                static_cast<GameEngine::entity_t>(entity));
-                            score.value = game_state_data.score;
-                        }
-                        break;
+                if (auto entity = rtype::ecs::NetworkIdIndex::of(registry_).find(player_id_)) {
+                    if (registry_.hasComponent<rtype::ecs::component::Lives>(*entity)) {
+                        auto& lives = registry_.getComponent<rtype::ecs::component::Lives>(*entity);
+                        lives.remaining = game_state_data.lives;
+                    }
+                    if (registry_.hasComponent<rtype::ecs::component::Score>(*entity)) {
+                        auto& score = registry_.getComponent<rtype::ecs::component::Score>(*entity);
+                        score.value = game_state_data.score;
                     }
                 }
             }
@@ -371,29 +347,11 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
             bool found = false;
             GameEngine::entity_t found_entity_id = 0;
 
-            {
-                auto view = registry_.view<rtype::ecs::component::NetworkId>();
-                for (auto entity : view) {
-                    GameEngine::entity_t entity_id = static_cast<GameEngine::entity_t>(entity);
-                    try {
-                        auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(entity_id);
-                        if (net_id.id == move_data.player_id) {
-                            bool is_player = false;
-                            if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_id)) {
-                                auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_id);
-                                if (tag.name == "Player") {
-                                    is_player = true;
-                                }
-                            }
-                            if (is_player) {
-                                found_entity_id = entity_id;
-                                found = true;
-                                break;
-                            }
-                        }
-                    } catch (const std::exception& e) {
-                        continue;
-                    }
+            if (auto entity_id = rtype::ecs::NetworkIdIndex::of(registry_).find(move_data.player_id)) {
+                if (registry_.hasComponent<rtype::ecs::component::Tag>(*entity_id) &&
+                    registry_.getComponent<rtype::ecs::component::Tag>(*entity_id).id == rtype::ecs::tags::Player) {
+                    found_entity_id = *entity_id;
+                    found = true;
                 }
             }
 
@@ -415,7 +373,7 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
                     rtype::constants::PLAYER_HEIGHT * rtype::constants::PLAYER_SCALE);
                 registry_.addComponent<rtype::ecs::component::Collidable>(
                     entity, rtype::ecs::component::CollisionLayer::Player);
-                registry_.addComponent<rtype::ecs::component::Tag>(entity, "Player");
+                registry_.addComponent<rtype::ecs::component::Tag>(entity, rtype::ecs::tags::Player);
                 registry_.addComponent<rtype::ecs::component::Lives>(entity, 3);
                 registry_.addComponent<rtype::ecs::component::Health>(entity, 100, 100);
 
@@ -424,11 +382,8 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
                 }
                 registry_.addComponent<rtype::ecs::component::NetworkInterpolation>(
                     entity, move_data.position_x, move_data.position_y, move_data.velocity_x, move_data.velocity_y);
-                drawable.animation_sequences["idle"] = {2};
-                drawable.animation_sequences["up"] = {2, 3, 4};
-                drawable.animation_sequences["down"] = {2, 1, 0};
-                drawable.current_state = "idle";
-                drawable.last_state = "idle";
+                drawable.clip = rtype::ecs::clips::ShipIdle;
+                drawable.last_clip = rtype::ecs::clips::ShipIdle;
                 drawable.animation_timer = 0.0f;
                 drawable.animation_speed = 0.1f;
                 drawable.current_sprite = 2;
@@ -472,28 +427,20 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
 
                         const float threshold = 0.5f;
 
-                        if (drawable.animation_sequences.empty()) {
-                            drawable.animation_sequences["idle"] = {2};
-                            drawable.animation_sequences["up"] = {2, 3, 4};
-                            drawable.animation_sequences["down"] = {2, 1, 0};
-                        }
-
-                        std::string new_state = drawable.current_state;
+                        rtype::ecs::ClipId new_clip = rtype::ecs::clips::ShipIdle;
 
                         if (move_data.velocity_y < -threshold) {
-                            new_state = "up";
+                            new_clip = rtype::ecs::clips::ShipUp;
                         } else if (move_data.velocity_y > threshold) {
-                            new_state = "down";
-                        } else {
-                            new_state = "idle";
+                            new_clip = rtype::ecs::clips::ShipDown;
                         }
 
-                        if (new_state != drawable.last_state) {
-                            drawable.current_state = new_state;
+                        if (new_clip != drawable.last_clip) {
+                            drawable.clip = new_clip;
                             drawable.animation_timer = 0.0f;
                             drawable.animation_frame = 0;
 
-                            drawable.last_state = new_state;
+                            drawable.last_clip = new_clip;
                         }
                     }
                 } catch (const std::exception& e) {
@@ -527,14 +474,8 @@ void Client::handle_server_message(const std::vector<uint8_t>& data) {
             GameEngine::entity_t entity_to_destroy = static_cast<GameEngine::entity_t>(-1);
             {
                 std::lock_guard<std::mutex> lock(registry_mutex_);
-                auto view = registry_.view<rtype::ecs::component::NetworkId>();
-                for (auto entity : view) {
-                    auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(
-                        static_cast<GameEngine::entity_t>(entity));
-                    if (net_id.id == leave_data.player_id) {
-                        entity_to_destroy = static_cast<GameEngine::entity_t>(entity);
-                        break;
-                    }
+                if (auto entity = rtype::ecs::NetworkIdIndex::of(registry_).find(leave_data.player_id)) {
+                    entity_to_destroy = *entity;
                 }
             }
 
@@ -682,17 +623,11 @@ void Client::send_shoot(int32_t x, int32_t y, int chargeLevel) {
     float pos_y = 0.0f;
     {
         std::lock_guard<std::mutex> lock(registry_mutex_);
-        auto view = registry_.view<rtype::ecs::component::NetworkId, rtype::ecs::component::Position>();
-        for (auto entity : view) {
-            auto& net_id =
-                registry_.getComponent<rtype::ecs::component::NetworkId>(static_cast<GameEngine::entity_t>(entity));
-            if (net_id.id == player_id_) {
-                auto& pos =
-                    registry_.getComponent<rtype::ecs::component::Position>(static_cast<GameEngine::entity_t>(entity));
-                pos_x = pos.x;
-                pos_y = pos.y;
-                break;
-            }
+        auto entity = rtype::ecs::NetworkIdIndex::of(registry_).find(player_id_);
+        if (entity && registry_.hasComponent<rtype::ecs::component::Position>(*entity)) {
+            auto& pos = registry_.getComponent<rtype::ecs::component::Position>(*entity);
+            pos_x = pos.x;
+            pos_y = pos.y;
         }
     }
 
@@ -901,6 +836,10 @@ void Client::send_heartbeat() {
 void Client::update(double dt) {
     send_heartbeat();
     audio_system_.update(registry_, dt);
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        registry_.commands().flush();
+    }
     network_system_.update(registry_, registry_mutex_);
 
     // Update ECS systems
@@ -947,27 +886,26 @@ void Client::update(double dt) {
             registry_.getComponent<rtype::ecs::component::Drawable>(static_cast<GameEngine::entity_t>(entity));
         auto& vel = registry_.getComponent<rtype::ecs::component::Velocity>(static_cast<GameEngine::entity_t>(entity));
 
-        if (drawable.animation_sequences.empty())
+        if (drawable.clip == rtype::ecs::clips::None)
             continue;
 
         if (vel.vy < 0)
-            drawable.current_state = "up";
+            drawable.clip = rtype::ecs::clips::ShipUp;
         else if (vel.vy > 0)
-            drawable.current_state = "down";
+            drawable.clip = rtype::ecs::clips::ShipDown;
         else
-            drawable.current_state = "idle";
+            drawable.clip = rtype::ecs::clips::ShipIdle;
 
-        if (drawable.current_state != drawable.last_state) {
+        const auto& seq = rtype::ecs::AnimationClips::get(drawable.clip).frames;
+        if (drawable.clip != drawable.last_clip) {
             drawable.animation_frame = 0;
-            const auto& seq = drawable.animation_sequences[drawable.current_state];
             if (!seq.empty())
                 drawable.current_sprite = seq[0];
             drawable.animation_timer = 0.0f;
-            drawable.last_state = drawable.current_state;
+            drawable.last_clip = drawable.clip;
             continue;
         }
 
-        const auto& seq = drawable.animation_sequences[drawable.current_state];
         if (seq.empty())
             continue;
 
@@ -996,7 +934,7 @@ void Client::update(double dt) {
             bool is_player = false;
             if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_id)) {
                 auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_id);
-                if (tag.name == "Player") {
+                if (tag.id == rtype::ecs::tags::Player) {
                     is_player = true;
                 }
             }
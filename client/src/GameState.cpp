@@ -2,6 +2,7 @@
 #include "MenuState.hpp"
 #include "SFMLRenderer.hpp"
 #include "GameConstants.hpp"
+#include "CommandBuffer.hpp"
 #include "systems/InputSystem.hpp"
 #include "systems/RenderSystem.hpp"
 #include "systems/TextureAnimationSystem.hpp"
@@ -31,9 +32,11 @@
 #include "components/FpsCounter.hpp"
 #include "components/PingStats.hpp"
 #include "components/CpuStats.hpp"
+#include "components/SystemTimings.hpp"
 #include "components/LagometerComponent.hpp"
 #include "systems/PingSystem.hpp"
 #include "systems/CpuMetricSystem.hpp"
+#include "systems/SystemTimingSystem.hpp"
 #include "systems/LagometerSystem.hpp"
 #include "components/SpectatorComponent.hpp"
 #include "systems/SpectatorSystem.hpp"
@@ -100,7 +103,7 @@ void GameState::on_enter(Renderer& renderer, Client& client) {
     auto view = registry.view<rtype::ecs::component::Tag>();
     for (auto entity : view) {
         auto& tag = registry.getComponent<rtype::ecs::component::Tag>(static_cast<GameEngine::entity_t>(entity));
-        if (tag.name == "Player") {
+        if (tag.id == rtype::ecs::tags::Player) {
             initial_player_count_++;
         }
     }
@@ -145,24 +148,13 @@ void GameState::handle_input(Renderer& renderer, StateManager& state_manager) {
                 std::mutex& registry_mutex = client_->get_registry_mutex();
                 std::lock_guard<std::mutex> lock(registry_mutex);
 
-                try {
-                    auto view = registry.view<rtype::ecs::component::MapBounds>();
-                    bool found = false;
-                    for (auto entity : view) {
-                        auto& bounds =
-                            registry.getComponent<rtype::ecs::component::MapBounds>(static_cast<std::size_t>(entity));
-                        bounds.maxX = static_cast<float>(event.size.width);
-                        bounds.maxY = static_cast<float>(event.size.height);
-                        found = true;
-                        break;
-                    }
-                    if (!found) {
-                        auto entity = registry.createEntity();
-                        registry.addComponent<rtype::ecs::component::MapBounds>(entity, 0.0f, 0.0f,
-                                                                                static_cast<float>(event.size.width),
-                                                                                static_cast<float>(event.size.height));
-                    }
-                } catch (const std::exception&) {
+                if (auto* bounds = registry.findContext<rtype::ecs::component::MapBounds>()) {
+                    bounds->maxX = static_cast<float>(event.size.width);
+                    bounds->maxY = static_cast<float>(event.size.height);
+                } else {
+                    registry.emplaceContext<rtype::ecs::component::MapBounds>(0.0f, 0.0f,
+                                                                              static_cast<float>(event.size.width),
+                                                                              static_cast<float>(event.size.height));
                 }
             }
         } else if (event.type == sf::Event::KeyPressed) {
@@ -665,7 +657,7 @@ void GameState::render(Renderer& renderer, Client& client) {
         auto view = registry.view<rtype::ecs::component::Tag>();
         for (auto entity : view) {
             auto& tag = registry.getComponent<rtype::ecs::component::Tag>(static_cast<GameEngine::entity_t>(entity));
-            if (tag.name == "Boss_1" || tag.name == "Boss_2") {
+            if (tag.id == rtype::ecs::tags::Boss1 || tag.id == rtype::ecs::tags::Boss2) {
                 boss_present = true;
                 break;
             }
@@ -681,11 +673,14 @@ void GameState::render(Renderer& renderer, Client& client) {
         std::mutex& registry_mutex = client.get_registry_mutex();
         std::lock_guard<std::mutex> lock(registry_mutex);
 
-        auto sfml_renderer =
-            std::make_shared<rtype::rendering::SFMLRenderer>(*renderer.get_window(), renderer.get_textures());
+        if (!sfml_renderer_) {
+            sfml_renderer_ =
+                std::make_shared<rtype::rendering::SFMLRenderer>(*renderer.get_window(), renderer.get_textures());
+        }
 
-        rtype::ecs::RenderSystem render_system(sfml_renderer, &renderer.get_accessibility_manager());
+        rtype::ecs::RenderSystem render_system(sfml_renderer_, &renderer.get_accessibility_manager());
         render_system.update(registry, 0.016f);
+        registry.commands().flush();
 
         if (multiplayer_) {
             rtype::ecs::LagometerSystem lagometer_system;
@@ -728,6 +723,9 @@ void GameState::render(Renderer& renderer, Client& client) {
         rtype::ecs::CpuMetricSystem cpu_metric_system;
         cpu_metric_system.update(registry, static_cast<double>(fps_dt));
 
+        rtype::ecs::SystemTimingSystem system_timing_system(client.get_system_manager());
+        system_timing_system.update(registry, static_cast<double>(fps_dt));
+
         if (has_chosen_spectate_ && spectator_system_) {
             spectator_system_->update(registry, static_cast<double>(fps_dt));
         }
@@ -1003,7 +1001,7 @@ void GameState::spawn_enemy_solo(GameEngine::Registry& registry) {
     registry.addComponent<rtype::ecs::component::Health>(entity, 100.0f, 100.0f);
     registry.addComponent<rtype::ecs::component::HitBox>(entity, 100.0f, 100.0f);
     registry.addComponent<rtype::ecs::component::Collidable>(entity, rtype::ecs::component::CollisionLayer::Enemy);
-    registry.addComponent<rtype::ecs::component::Tag>(entity, "EnemyMonster");
+    registry.addComponent<rtype::ecs::component::Tag>(entity, rtype::ecs::tags::EnemyMonster);
     registry.addComponent<rtype::ecs::component::NetworkInterpolation>(entity, x, y, -200.0f, 0.0f);
 }
 
@@ -1027,7 +1025,7 @@ void GameState::spawn_player_projectile(GameEngine::Registry& registry, GameEngi
     registry.addComponent<rtype::ecs::component::HitBox>(projectile, 32.0f, 32.0f);
     registry.addComponent<rtype::ecs::component::Collidable>(projectile,
                                                              rtype::ecs::component::CollisionLayer::PlayerProjectile);
-    registry.addComponent<rtype::ecs::component::Tag>(projectile, "PlayerProjectile");
+    registry.addComponent<rtype::ecs::component::Tag>(projectile, rtype::ecs::tags::PlayerProjectile);
     registry.addComponent<rtype::ecs::component::Drawable>(projectile, "shot", 0, 0, 29, 33, 3.0f, 3.0f, 4, 0.05f,
                                                            true);
     registry.addComponent<rtype::ecs::component::NetworkInterpolation>(projectile, spawn_x, spawn_y,
@@ -1080,6 +1078,16 @@ void GameState::createDevMetrics(GameEngine::Registry& registry, float windowWid
     registry.addComponent<rtype::ecs::component::CpuStats>(cpu_entity);
     registry.addComponent<rtype::ecs::component::TextDrawable>(cpu_entity, dev_font_, "CPU: -- ms", 20,
                                                                sf::Color::Green);
+
+    // Per-system tick timings of the local SystemManager
+    auto timings_entity = registry.createEntity();
+    float y_timings = 100.0f;
+
+    registry.addComponent<rtype::ecs::component::Position>(timings_entity, x - 170.0f, y_timings);
+    registry.addComponent<rtype::ecs::component::UITag>(timings_entity);
+    registry.addComponent<rtype::ecs::component::SystemTimings>(timings_entity);
+    registry.addComponent<rtype::ecs::component::TextDrawable>(timings_entity, dev_font_, "SYSTEMS: --", 12,
+                                                               sf::Color::Green);
 }
 
 void GameState::createLagometer(GameEngine::Registry& registry, float windowWidth) {
@@ -1,4 +1,5 @@
 #include "NetworkSystem.hpp"
+#include "NetworkIdIndex.hpp"
 #include "components/TextureAnimation.hpp"
 #include "net/MessageData.hpp"
 #include "components/HitBox.hpp"
@@ -99,7 +100,7 @@ void NetworkSystem::handle_spawn(GameEngine::Registry& registry, const rtype::ne
                 registry.addComponent<rtype::ecs::component::NetworkInterpolation>(
                     entity, data.position_x, data.position_y, data.velocity_x, data.velocity_y);
             }
-            registry.addComponent<rtype::ecs::component::Tag>(entity, "Player");
+            registry.addComponent<rtype::ecs::component::Tag>(entity, rtype::ecs::tags::Player);
             registry.addComponent<rtype::ecs::component::HitBox>(entity, 165.0f, 110.0f);
         } else if (data.entity_type == rtype::net::EntityType::ENEMY) {
             std::string sprite_name = "enemy_basic";
@@ -172,10 +173,9 @@ void NetworkSystem::handle_spawn(GameEngine::Registry& registry, const rtype::ne
                                                                      rtype::ecs::component::CollisionLayer::Enemy);
 
             // Add tags for boss detection
-            if (data.sub_type == 100) {
-                registry.addComponent<rtype::ecs::component::Tag>(entity, "Boss_1");
-            } else if (data.sub_type == 101) {
-                registry.addComponent<rtype::ecs::component::Tag>(entity, "Boss_2");
+            if (data.sub_type == 100 || data.sub_type == 101) {
+                registry.addComponent<rtype::ecs::component::Tag>(
+                    entity, rtype::ecs::tags::tagOfSpawn(data.entity_type, data.sub_type));
             }
             registry.addComponent<rtype::ecs::component::NetworkInterpolation>(entity, data.position_x, data.position_y,
                                                                                data.velocity_x, data.velocity_y);
@@ -264,27 +264,27 @@ void NetworkSystem::handle_spawn(GameEngine::Registry& registry, const rtype::ne
             float scale_y = rtype::constants::OBSTACLE_SCALE;
             float obs_w = rtype::constants::OBSTACLE_WIDTH;
             float obs_h = rtype::constants::OBSTACLE_HEIGHT;
-            std::string tag_name = "Obstacle";
+            rtype::ecs::TagId tag = rtype::ecs::tags::Obstacle;
 
             if (data.sub_type == 1) {
                 sprite_name = "floor_obstacle";
                 obs_w = rtype::constants::FLOOR_OBSTACLE_WIDTH;
                 obs_h = rtype::constants::FLOOR_OBSTACLE_HEIGHT;
-                tag_name = "Obstacle_Floor";
+                tag = rtype::ecs::tags::ObstacleFloor;
             } else if (data.sub_type == 2) {
                 sprite_name = "reverse_floor_obstacle";
                 obs_w = rtype::constants::FLOOR_OBSTACLE_WIDTH;
                 obs_h = rtype::constants::FLOOR_OBSTACLE_HEIGHT;
                 scale_x = rtype::constants::OBSTACLE_SCALE;
                 scale_y = rtype::constants::OBSTACLE_SCALE;
-                tag_name = "Obstacle_Train_3";
+                tag = rtype::ecs::tags::ObstacleTrain3;
             } else if (data.sub_type == 3) {
                 sprite_name = "reverse_obstacle1";
                 obs_w = rtype::constants::OBSTACLE_WIDTH;
                 obs_h = rtype::constants::OBSTACLE_HEIGHT;
                 scale_x = rtype::constants::OBSTACLE_SCALE;
                 scale_y = rtype::constants::OBSTACLE_SCALE;
-                tag_name = "Obstacle_Train_4";
+                tag = rtype::ecs::tags::ObstacleTrain4;
             }
 
             registry.addComponent<rtype::ecs::component::Drawable>(entity, sprite_name, static_cast<uint32_t>(0),
@@ -293,10 +293,10 @@ void NetworkSystem::handle_spawn(GameEngine::Registry& registry, const rtype::ne
             registry.addComponent<rtype::ecs::component::HitBox>(entity, obs_w * scale_x, obs_h * scale_y);
             registry.addComponent<rtype::ecs::component::Collidable>(entity,
                                                                      rtype::ecs::component::CollisionLayer::Obstacle);
-            registry.addComponent<rtype::ecs::component::Tag>(entity, tag_name);
+            registry.addComponent<rtype::ecs::component::Tag>(entity, tag);
         } else if (data.entity_type == rtype::net::EntityType::POWERUP) {
             std::string sprite_name = "force_pod";
-            std::string tag_name = (data.sub_type == 1) ? "ForcePodItem" : "ForcePod";
+            rtype::ecs::TagId tag = (data.sub_type == 1) ? rtype::ecs::tags::ForcePodItem : rtype::ecs::tags::ForcePod;
 
             registry.addComponent<rtype::ecs::component::Drawable>(entity, sprite_name + "_0", static_cast<uint32_t>(0),
                                                                    static_cast<uint32_t>(0), static_cast<uint32_t>(0),
@@ -313,7 +313,7 @@ void NetworkSystem::handle_spawn(GameEngine::Registry& registry, const rtype::ne
                 registry.addComponent<rtype::ecs::component::Collidable>(
                     entity, rtype::ecs::component::CollisionLayer::Companion);
             }
-            registry.addComponent<rtype::ecs::component::Tag>(entity, tag_name);
+            registry.addComponent<rtype::ecs::component::Tag>(entity, tag);
         }
 
     } catch (const std::exception& e) {
@@ -342,78 +342,52 @@ void NetworkSystem::handle_move(GameEngine::Registry& registry, const rtype::net
             vy = data.velocity_y;
 
             if (data.flags & 0x01) {
-                auto view = registry.view<rtype::ecs::component::NetworkId>();
-                for (auto entity : view) {
-                    GameEngine::entity_t ecs_entity = static_cast<GameEngine::entity_t>(entity);
-                    auto& net_id = registry.getComponent<rtype::ecs::component::NetworkId>(ecs_entity);
-                    if (net_id.id == entity_id) {
-                        if (registry.hasComponent<rtype::ecs::component::HitFlash>(ecs_entity)) {
-                            auto& flash = registry.getComponent<rtype::ecs::component::HitFlash>(ecs_entity);
-                            flash.active = true;
-                            flash.timer = flash.duration;
-                        } else {
-                            registry.addComponent<rtype::ecs::component::HitFlash>(ecs_entity, 0.3f, 0.3f, true);
-                        }
-                        std::cout << "[HitFlash] Received for entity " << entity_id << std::endl;
-                        break;
+                if (auto ecs_entity = rtype::ecs::NetworkIdIndex::of(registry).find(entity_id)) {
+                    if (registry.hasComponent<rtype::ecs::component::HitFlash>(*ecs_entity)) {
+                        auto& flash = registry.getComponent<rtype::ecs::component::HitFlash>(*ecs_entity);
+                        flash.active = true;
+                        flash.timer = flash.duration;
+                    } else {
+                        registry.addComponent<rtype::ecs::component::HitFlash>(*ecs_entity, 0.3f, 0.3f, true);
                     }
+                    std::cout << "[HitFlash] Received for entity " << entity_id << std::endl;
                 }
             }
         }
 
-        auto view = registry.view<rtype::ecs::component::NetworkId>();
-        bool found = false;
-
-        for (auto entity : view) {
-            GameEngine::entity_t entity_id_ecs = static_cast<GameEngine::entity_t>(entity);
-            try {
-                auto& net_id = registry.getComponent<rtype::ecs::component::NetworkId>(entity_id_ecs);
-                if (net_id.id == entity_id) {
-                    if (entity_id == player_id_) {
-                        found = true;
-                        break;
-                    }
-
-                    if (!registry.hasComponent<rtype::ecs::component::Position>(entity_id_ecs) ||
-                        !registry.hasComponent<rtype::ecs::component::Velocity>(entity_id_ecs)) {
-                        found = true;
-                        break;
-                    }
+        auto found = rtype::ecs::NetworkIdIndex::of(registry).find(entity_id);
+        if (!found || entity_id == player_id_) {
+            return;
+        }
+        GameEngine::entity_t entity_id_ecs = *found;
 
-                    bool is_projectile = registry.hasComponent<rtype::ecs::component::Projectile>(entity_id_ecs);
+        if (!registry.hasComponent<rtype::ecs::component::Position>(entity_id_ecs) ||
+            !registry.hasComponent<rtype::ecs::component::Velocity>(entity_id_ecs)) {
+            return;
+        }
 
-                    if (is_projectile) {
-                        auto& pos = registry.getComponent<rtype::ecs::component::Position>(entity_id_ecs);
-                        auto& vel = registry.getComponent<rtype::ecs::component::Velocity>(entity_id_ecs);
-                        pos.x = x;
-                        pos.y = y;
-                        vel.vx = vx;
-                        vel.vy = vy;
-                    } else {
-                        if (!registry.hasComponent<rtype::ecs::component::NetworkInterpolation>(entity_id_ecs)) {
-                            auto& pos = registry.getComponent<rtype::ecs::component::Position>(entity_id_ecs);
-                            registry.addComponent<rtype::ecs::component::NetworkInterpolation>(entity_id_ecs, pos.x,
-                                                                                               pos.y, vx, vy);
-                        }
-
-                        auto& interp =
-                            registry.getComponent<rtype::ecs::component::NetworkInterpolation>(entity_id_ecs);
-                        interp.target_x = x;
-                        interp.target_y = y;
-                        interp.target_vx = vx;
-                        interp.target_vy = vy;
-                        interp.last_update_time = std::chrono::steady_clock::now();
-                    }
+        bool is_projectile = registry.hasComponent<rtype::ecs::component::Projectile>(entity_id_ecs);
 
-                    found = true;
-                    break;
-                }
-            } catch (const std::exception& e) {
-                continue;
+        if (is_projectile) {
+            auto& pos = registry.getComponent<rtype::ecs::component::Position>(entity_id_ecs);
+            auto& vel = registry.getComponent<rtype::ecs::component::Velocity>(entity_id_ecs);
+            pos.x = x;
+            pos.y = y;
+            vel.vx = vx;
+            vel.vy = vy;
+        } else {
+            if (!registry.hasComponent<rtype::ecs::component::NetworkInterpolation>(entity_id_ecs)) {
+                auto& pos = registry.getComponent<rtype::ecs::component::Position>(entity_id_ecs);
+                registry.addComponent<rtype::ecs::component::NetworkInterpolation>(entity_id_ecs, pos.x, pos.y, vx,
+                                                                                   vy);
             }
-        }
 
-        if (!found) {
+            auto& interp = registry.getComponent<rtype::ecs::component::NetworkInterpolation>(entity_id_ecs);
+            interp.target_x = x;
+            interp.target_y = y;
+            interp.target_vx = vx;
+            interp.target_vy = vy;
+            interp.last_update_time = std::chrono::steady_clock::now();
         }
     } catch (const std::exception& e) {
     }
@@ -423,59 +397,49 @@ void NetworkSystem::handle_destroy(GameEngine::Registry& registry, const rtype::
     try {
         auto data = serializer_.deserialize_entity_destroy(packet);
 
-        auto view = registry.view<rtype::ecs::component::NetworkId>();
+        auto found = rtype::ecs::NetworkIdIndex::of(registry).find(data.entity_id);
+        if (!found) {
+            return;
+        }
+        GameEngine::entity_t entity_id_ecs = *found;
 
-        for (auto entity : view) {
-            GameEngine::entity_t entity_id_ecs = static_cast<GameEngine::entity_t>(entity);
-            try {
-                auto& net_id = registry.getComponent<rtype::ecs::component::NetworkId>(entity_id_ecs);
-                if (net_id.id == data.entity_id) {
-                    bool is_player = registry.hasComponent<rtype::ecs::component::Weapon>(entity_id_ecs);
-                    bool is_enemy = !is_player && registry.hasComponent<rtype::ecs::component::Health>(entity_id_ecs);
-
-                    if (is_player || is_enemy) {
-                        float explosion_x = 0.0f;
-                        float explosion_y = 0.0f;
-
-                        if (registry.hasComponent<rtype::ecs::component::Position>(entity_id_ecs)) {
-                            auto& pos = registry.getComponent<rtype::ecs::component::Position>(entity_id_ecs);
-                            explosion_x = pos.x;
-                            explosion_y = pos.y;
-                        }
-
-                        auto explosion_entity = registry.createEntity();
-                        registry.addComponent<rtype::ecs::component::Position>(explosion_entity, explosion_x,
-                                                                               explosion_y);
-                        registry.addComponent<rtype::ecs::component::Explosion>(explosion_entity);
-                        registry.addComponent<rtype::ecs::component::Drawable>(explosion_entity, "explosion", 5, 0, 37,
-                                                                               44, 4.0f, 4.0f, 6, 0.1f, false);
-                        auto& explosion_drawable =
-                            registry.getComponent<rtype::ecs::component::Drawable>(explosion_entity);
-                        constexpr int EXPLOSION_FRAME_WIDTH = 37;
-                        constexpr int EXPLOSION_FRAME_HEIGHT = 44;
-                        constexpr int EXPLOSION_FRAMES_PER_ROW = 6;
-                        explosion_drawable.rect_x = 5;
-                        explosion_drawable.rect_y = 0;
-                        explosion_drawable.rect_width = EXPLOSION_FRAME_WIDTH;
-                        explosion_drawable.rect_height = EXPLOSION_FRAME_HEIGHT;
-                        explosion_drawable.frame_count = EXPLOSION_FRAMES_PER_ROW;
-                        explosion_drawable.animation_speed = 0.1f;
-                        explosion_drawable.loop = false;
-                        explosion_drawable.current_sprite = 0;
-                        explosion_drawable.animation_sequences["explosion"] = {5, 4, 3, 2, 1, 0};
-                        explosion_drawable.current_state = "explosion";
-                        explosion_drawable.animation_frame = 5;
-
-                        registry.addComponent<rtype::ecs::component::AudioEvent>(
-                            explosion_entity, rtype::ecs::component::AudioEventType::EXPLOSION);
-                    }
-                    registry.destroyEntity(entity_id_ecs);
-                    return;
-                }
-            } catch (const std::exception& e) {
-                continue;
+        bool is_player = registry.hasComponent<rtype::ecs::component::Weapon>(entity_id_ecs);
+        bool is_enemy = !is_player && registry.hasComponent<rtype::ecs::component::Health>(entity_id_ecs);
+
+        if (is_player || is_enemy) {
+            float explosion_x = 0.0f;
+            float explosion_y = 0.0f;
+
+            if (registry.hasComponent<rtype::ecs::component::Position>(entity_id_ecs)) {
+                auto& pos = registry.getComponent<rtype::ecs::component::Position>(entity_id_ecs);
+                explosion_x = pos.x;
+                explosion_y = pos.y;
             }
+
+            auto explosion_entity = registry.createEntity();
+            registry.addComponent<rtype::ecs::component::Position>(explosion_entity, explosion_x, explosion_y);
+            registry.addComponent<rtype::ecs::component::Explosion>(explosion_entity);
+            registry.addComponent<rtype::ecs::component::Drawable>(explosion_entity, "explosion", 5, 0, 37, 44, 4.0f,
+                                                                   4.0f, 6, 0.1f, false);
+            auto& explosion_drawable = registry.getComponent<rtype::ecs::component::Drawable>(explosion_entity);
+            constexpr int EXPLOSION_FRAME_WIDTH = 37;
+            constexpr int EXPLOSION_FRAME_HEIGHT = 44;
+            constexpr int EXPLOSION_FRAMES_PER_ROW = 6;
+            explosion_drawable.rect_x = 5;
+            explosion_drawable.rect_y = 0;
+            explosion_drawable.rect_width = EXPLOSION_FRAME_WIDTH;
+            explosion_drawable.rect_height = EXPLOSION_FRAME_HEIGHT;
+            explosion_drawable.frame_count = EXPLOSION_FRAMES_PER_ROW;
+            explosion_drawable.animation_speed = 0.1f;
+            explosion_drawable.loop = false;
+            explosion_drawable.current_sprite = 0;
+            explosion_drawable.clip = rtype::ecs::clips::Explosion;
+            explosion_drawable.animation_frame = 5;
+
+            registry.addComponent<rtype::ecs::component::AudioEvent>(explosion_entity,
+                                                                     rtype::ecs::component::AudioEventType::EXPLOSION);
         }
+        registry.destroyEntity(entity_id_ecs);
     } catch (const std::exception& e) {
     }
 }
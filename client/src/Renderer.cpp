@@ -280,8 +280,9 @@ void Renderer::draw_entities() {
         }
 
         sprite.setColor(color);
-        window_->draw(sprite);
+        entity_batch_.draw(sprite);
     }
+    entity_batch_.flush(*window_);
 }
 
 sf::Sprite Renderer::create_sprite(const Entity& entity) {
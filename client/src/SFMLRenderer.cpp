@@ -9,18 +9,17 @@ SFMLRenderer::SFMLRenderer(sf::RenderWindow& window, std::unordered_map<std::str
 
 void SFMLRenderer::draw_sprite(const RenderData& data) {
     if (data.texture_name == "__RECTANGLE__") {
-        sf::RectangleShape rect(sf::Vector2f(data.rect_width, data.rect_height));
-        rect.setPosition(data.x, data.y);
-        rect.setFillColor(sf::Color(data.color_r, data.color_g, data.color_b, data.color_a));
-        window_.draw(rect);
+        batch_.draw_rect(sf::FloatRect(data.x, data.y, data.rect_width, data.rect_height),
+                         sf::Color(data.color_r, data.color_g, data.color_b, data.color_a));
         return;
     }
 
-    if (textures_.find(data.texture_name) == textures_.end()) {
+    auto it = textures_.find(data.texture_name);
+    if (it == textures_.end()) {
         return;
     }
 
-    const sf::Texture& texture = textures_.at(data.texture_name);
+    const sf::Texture& texture = it->second;
     uint32_t texture_width = texture.getSize().x;
     uint32_t texture_height = texture.getSize().y;
 
@@ -36,7 +35,11 @@ void SFMLRenderer::draw_sprite(const RenderData& data) {
     }
     sprite.setColor(sf::Color(data.color_r, data.color_g, data.color_b, data.color_a));
 
-    window_.draw(sprite);
+    batch_.draw(sprite);
+}
+
+void SFMLRenderer::flush() {
+    batch_.flush(window_);
 }
 
 void SFMLRenderer::clear() {
@@ -44,6 +47,7 @@ void SFMLRenderer::clear() {
 }
 
 void SFMLRenderer::display() {
+    batch_.flush(window_);
     window_.display();
 }
 
@@ -107,6 +111,7 @@ sf::IntRect SFMLRenderer::calculate_texture_rect(const RenderData& data, uint32_
 }
 
 void SFMLRenderer::draw_parallax_background(const std::string& texture_name, float view_y) {
+    batch_.flush(window_);
     if (textures_.find(texture_name) == textures_.end()) {
         return;
     }
@@ -0,0 +1,81 @@
+#include "SpriteBatch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+
+namespace rtype::rendering {
+
+void SpriteBatch::draw(const sf::Sprite& sprite) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture) {
+        return;
+    }
+
+    const sf::IntRect rect = sprite.getTextureRect();
+    const float width = static_cast<float>(std::abs(rect.width));
+    const float height = static_cast<float>(std::abs(rect.height));
+    const float left = static_cast<float>(rect.left);
+    const float top = static_cast<float>(rect.top);
+    const float right = left + static_cast<float>(rect.width);
+    const float bottom = top + static_cast<float>(rect.height);
+
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Vector2f corners[4] = {transform.transformPoint(0.0f, 0.0f), transform.transformPoint(width, 0.0f),
+                                     transform.transformPoint(width, height), transform.transformPoint(0.0f, height)};
+    const sf::Vector2f tex_coords[4] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+    append_quad(batch_for(texture), corners, tex_coords, sprite.getColor());
+}
+
+void SpriteBatch::draw_rect(const sf::FloatRect& rect, const sf::Color& color) {
+    const sf::Vector2f corners[4] = {{rect.left, rect.top},
+                                     {rect.left + rect.width, rect.top},
+                                     {rect.left + rect.width, rect.top + rect.height},
+                                     {rect.left, rect.top + rect.height}};
+    const sf::Vector2f tex_coords[4] = {};
+    append_quad(batch_for(nullptr), corners, tex_coords, color);
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    last_draw_calls_ = 0;
+    for (std::size_t index : order_) {
+        Batch& batch = batches_[index];
+        if (batch.vertices.getVertexCount() == 0) {
+            continue;
+        }
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        target.draw(batch.vertices, states);
+        batch.vertices.clear();
+        ++last_draw_calls_;
+    }
+    order_.clear();
+}
+
+sf::VertexArray& SpriteBatch::batch_for(const sf::Texture* texture) {
+    if (last_batch_ >= batches_.size() || batches_[last_batch_].texture != texture) {
+        auto it = std::find_if(batches_.begin(), batches_.end(), [texture](const Batch& batch) {
+            return batch.texture == texture;
+        });
+        if (it == batches_.end()) {
+            batches_.push_back({texture});
+            it = std::prev(batches_.end());
+        }
+        last_batch_ = static_cast<std::size_t>(it - batches_.begin());
+    }
+    Batch& batch = batches_[last_batch_];
+    if (batch.vertices.getVertexCount() == 0) {
+        order_.push_back(last_batch_);
+    }
+    return batch.vertices;
+}
+
+void SpriteBatch::append_quad(sf::VertexArray& vertices, const sf::Vector2f (&corners)[4],
+                              const sf::Vector2f (&tex_coords)[4], const sf::Color& color) {
+    static constexpr int QuadTriangles[6] = {0, 1, 2, 0, 2, 3};
+    for (int corner : QuadTriangles) {
+        vertices.append(sf::Vertex(corners[corner], color, tex_coords[corner]));
+    }
+}
+
+} // namespace rtype::rendering
@@ -0,0 +1,59 @@
+// Build: g++ -std=c++20 -O3 -I../../../ecs/include -I../../../shared bench_sparse_set.cpp -o bench_sparse_set
+#include "benchmark_common.hpp"
+#include "SparseArray.hpp"
+#include "SparseSet.hpp"
+
+int main(int argc, char** argv) {
+    size_t N = (argc > 1) ? std::stoi(argv[1]) : 10000;
+    size_t spread = (argc > 2) ? std::stoi(argv[2]) : 10;
+
+    // Live entities are scattered over N * spread ids, like a long session where ids only grow
+    rtype::ecs::SparseArray<Component> sparseArray;
+    rtype::ecs::SparseSet<Component> sparseSet;
+
+    long long t_insert_array = measure("Insertion", [&]() {
+        for (size_t i = 0; i < N; ++i) {
+            sparseArray.emplace_at(i * spread);
+        }
+    });
+
+    long long t_insert_set = measure("Insertion", [&]() {
+        for (size_t i = 0; i < N; ++i) {
+            sparseSet.emplace_at(i * spread);
+        }
+    });
+
+    volatile float total_x = 0;
+    long long t_iter_array = measure("Iteration", [&]() {
+        for (auto& slot : sparseArray) {
+            if (slot.has_value()) {
+                total_x += slot->x;
+                slot->x += slot->vx;
+            }
+        }
+    });
+
+    long long t_iter_set = measure("Iteration", [&]() {
+        for (auto& component : sparseSet) {
+            total_x += component.x;
+            component.x += component.vx;
+        }
+    });
+
+    long long t_erase_array = measure("Erase", [&]() {
+        for (size_t i = 0; i < N; i += 2) {
+            sparseArray.erase(i * spread);
+        }
+    });
+
+    long long t_erase_set = measure("Erase", [&]() {
+        for (size_t i = 0; i < N; i += 2) {
+            sparseSet.erase(i * spread);
+        }
+    });
+
+    std::cout << "SPARSE_ARRAY," << N << "," << t_insert_array << "," << t_iter_array << "," << t_erase_array
+              << std::endl;
+    std::cout << "SPARSE_SET," << N << "," << t_insert_set << "," << t_iter_set << "," << t_erase_set << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Build: g++ -std=c++20 -O3 -I../../../ecs/include bench_aabb_kernel.cpp ../../../ecs/src/AabbKernel.cpp
+//        -o bench_aabb_kernel
+// Add -mavx2 to build the 8-wide kernel instead of the 4-wide SSE one
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AabbKernel.hpp"
+
+struct Box {
+    float x, y, width, height;
+};
+
+// Same expression as CollisionSystem::CheckAABBCollision
+bool overlaps(const Box& a, const Box& b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+// Projectile-sized boxes spread over the 1920x1080 map
+std::vector<Box> randomBoxes(std::size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> x(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> y(0.0f, 1080.0f);
+    std::uniform_real_distribution<float> size(16.0f, 96.0f);
+    std::vector<Box> boxes(count);
+    for (auto& box : boxes) {
+        box = {x(rng), y(rng), size(rng), size(rng)};
+    }
+    return boxes;
+}
+
+template <typename Func> double measure(int reps, Func f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < reps; ++i) {
+        f();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = (argc > 1) ? std::stoul(argv[1]) : 1000;
+    int reps = (argc > 2) ? std::stoi(argv[2]) : 100;
+
+    std::mt19937 rng(42);
+    auto queries = randomBoxes(count, rng);
+    auto candidates = randomBoxes(count, rng);
+    rtype::ecs::AabbBlock block;
+    for (const auto& box : candidates) {
+        block.push(box.x, box.y, box.width, box.height);
+    }
+
+    // Every query box against every candidate box, hits are summed so the loops cannot be optimized out
+    std::size_t scalar_hits = 0;
+    double t_scalar = measure(reps, [&]() {
+        scalar_hits = 0;
+        for (const auto& query : queries) {
+            for (const auto& candidate : candidates) {
+                scalar_hits += overlaps(query, candidate);
+            }
+        }
+    });
+
+    std::size_t kernel_hits = 0;
+    double t_kernel = measure(reps, [&]() {
+        kernel_hits = 0;
+        for (const auto& query : queries) {
+            for (std::size_t first = 0; first < block.size(); first += 64) {
+                auto mask = rtype::ecs::overlapMask(block, first, query.x, query.y, query.width, query.height);
+                kernel_hits += static_cast<std::size_t>(std::popcount(mask));
+            }
+        }
+    });
+
+    if (scalar_hits != kernel_hits) {
+        std::cerr << "Hit counts differ: " << scalar_hits << " vs " << kernel_hits << std::endl;
+        return 1;
+    }
+
+    // Columns: variant, pairs per tick, microseconds, pairs per second
+    double pairs = static_cast<double>(count) * static_cast<double>(count);
+    std::cout << "SCALAR," << pairs << "," << t_scalar << "," << pairs / t_scalar * 1e6 << std::endl;
+    std::cout << "KERNEL_" << rtype::ecs::overlapKernelIsa() << "," << pairs << "," << t_kernel << ","
+              << pairs / t_kernel * 1e6 << std::endl;
+    return 0;
+}
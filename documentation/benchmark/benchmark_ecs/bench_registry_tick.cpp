@@ -0,0 +1,144 @@
+// Build: g++ -std=c++20 -O3 -I../../../ecs/include -I../../../shared bench_registry_tick.cpp ../../../ecs/src/*.cpp
+//        -lpthread -o bench_registry_tick
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "Registry.hpp"
+#include "components/Health.hpp"
+#include "components/HitBox.hpp"
+#include "components/NetworkId.hpp"
+#include "components/Position.hpp"
+#include "components/Tag.hpp"
+#include "components/Velocity.hpp"
+
+using namespace rtype::ecs::component;
+
+// Previous lookup path: type_index hashed into a map on every access
+class TypeIndexStore {
+  public:
+    template <typename T, typename... Args> T& addComponent(GameEngine::entity_t entity, Args&&... args) {
+        return storage<T>().emplace_at(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T> bool hasComponent(GameEngine::entity_t entity) {
+        auto it = _storages.find(std::type_index(typeid(T)));
+        return it != _storages.end() && it->second->contains(entity);
+    }
+
+    template <typename T> T& getComponent(GameEngine::entity_t entity) {
+        return storage<T>().get(entity);
+    }
+
+  private:
+    template <typename T> rtype::ecs::SparseSet<T>& storage() {
+        auto& slot = _storages[std::type_index(typeid(T))];
+        if (!slot) {
+            slot = std::make_unique<rtype::ecs::SparseSet<T>>();
+        }
+        return static_cast<rtype::ecs::SparseSet<T>&>(*slot);
+    }
+
+    std::unordered_map<std::type_index, std::unique_ptr<GameEngine::IComponentStorage>> _storages;
+};
+
+template <typename Store> void populate(Store& store, std::vector<GameEngine::entity_t>& entities, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        GameEngine::entity_t entity = entities[i];
+        store.template addComponent<Position>(entity, static_cast<float>(i % 1920), static_cast<float>(i % 1080));
+        store.template addComponent<Velocity>(entity, -100.0f, 0.0f);
+        store.template addComponent<HitBox>(entity, 32.0f, 32.0f);
+        store.template addComponent<NetworkId>(entity, static_cast<uint32_t>(20000 + i));
+        if (i % 3 == 0) {
+            store.template addComponent<Health>(entity, 100, 100);
+            store.template addComponent<Tag>(entity, "Enemy");
+        } else {
+            store.template addComponent<Tag>(entity, "Projectile");
+        }
+    }
+}
+
+// One simulated tick: movement, damage and broadcast style lookups, as the systems do them per entity
+template <typename Store> float tick(Store& store, const std::vector<GameEngine::entity_t>& entities, float dt) {
+    float checksum = 0.0f;
+    for (auto entity : entities) {
+        if (store.template hasComponent<Position>(entity) && store.template hasComponent<Velocity>(entity)) {
+            auto& pos = store.template getComponent<Position>(entity);
+            const auto& vel = store.template getComponent<Velocity>(entity);
+            pos.x += vel.vx * dt;
+            pos.y += vel.vy * dt;
+        }
+    }
+    for (auto entity : entities) {
+        if (store.template hasComponent<Health>(entity) && store.template hasComponent<HitBox>(entity)) {
+            auto& health = store.template getComponent<Health>(entity);
+            health.hp = health.max_hp - static_cast<int>(store.template getComponent<HitBox>(entity).width);
+        }
+    }
+    for (auto entity : entities) {
+        if (store.template hasComponent<NetworkId>(entity) && store.template hasComponent<Position>(entity) &&
+            store.template hasComponent<Tag>(entity)) {
+            checksum += store.template getComponent<Position>(entity).x +
+                        static_cast<float>(store.template getComponent<NetworkId>(entity).id);
+        }
+    }
+    return checksum;
+}
+
+template <typename Func> long long measure(Func f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = (argc > 1) ? std::stoul(argv[1]) : 2000;
+    int ticks = (argc > 2) ? std::stoi(argv[2]) : 1000;
+    constexpr float dt = 1.0f / 60.0f;
+
+    GameEngine::Registry registry;
+    std::vector<GameEngine::entity_t> entities;
+    for (std::size_t i = 0; i < count; ++i) {
+        entities.push_back(registry.createEntity());
+    }
+    TypeIndexStore typeIndexStore;
+    populate(registry, entities, count);
+    populate(typeIndexStore, entities, count);
+
+    volatile float sink = 0.0f;
+    long long t_type_index = measure([&]() {
+        for (int i = 0; i < ticks; ++i) {
+            sink = sink + tick(typeIndexStore, entities, dt);
+        }
+    });
+    long long t_family = measure([&]() {
+        for (int i = 0; i < ticks; ++i) {
+            sink = sink + tick(registry, entities, dt);
+        }
+    });
+    long long t_view = measure([&]() {
+        for (int i = 0; i < ticks; ++i) {
+            registry.view<Position, Velocity>().each([&](auto, Position& pos, const Velocity& vel) {
+                pos.x += vel.vx * dt;
+                pos.y += vel.vy * dt;
+            });
+            registry.view<Health, HitBox>().each([](auto, Health& health, const HitBox& box) {
+                health.hp = health.max_hp - static_cast<int>(box.width);
+            });
+            float checksum = 0.0f;
+            registry.view<NetworkId, Position, Tag>().each([&](auto, const NetworkId& id, const Position& pos, auto&) {
+                checksum += pos.x + static_cast<float>(id.id);
+            });
+            sink = sink + checksum;
+        }
+    });
+
+    // Columns: implementation, entities, microseconds per tick
+    std::cout << "TYPE_INDEX_LOOKUP," << count << "," << static_cast<double>(t_type_index) / ticks << std::endl;
+    std::cout << "FAMILY_ID_LOOKUP," << count << "," << static_cast<double>(t_family) / ticks << std::endl;
+    std::cout << "FAMILY_ID_VIEW," << count << "," << static_cast<double>(t_view) / ticks << std::endl;
+    return 0;
+}
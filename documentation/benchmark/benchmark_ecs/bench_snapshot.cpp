@@ -0,0 +1,63 @@
+// Build: g++ -std=c++20 -O3 -I../../../ecs/include -I../../../shared bench_snapshot.cpp ../../../ecs/src/*.cpp
+//        -lpthread -o bench_snapshot
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ComponentSnapshots.hpp"
+
+using namespace rtype::ecs::component;
+
+// Session-like mix: a few players, enemies with weapons, and a majority of projectiles
+void populate(GameEngine::Registry& registry, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<Position>(entity, static_cast<float>(i % 1920), static_cast<float>(i % 1080));
+        registry.addComponent<Velocity>(entity, -100.0f, 0.0f);
+        registry.addComponent<HitBox>(entity, 32.0f, 32.0f);
+        registry.addComponent<NetworkId>(entity, static_cast<uint32_t>(20000 + i));
+        if (i < 4) {
+            registry.addComponent<Tag>(entity, "Player");
+            registry.addComponent<PlayerName>(entity, "Player" + std::to_string(i));
+            registry.addComponent<Weapon>(entity);
+            registry.addComponent<Health>(entity, 100, 100);
+            registry.addComponent<Lives>(entity);
+            registry.addComponent<Score>(entity);
+        } else if (i % 4 == 0) {
+            registry.addComponent<Tag>(entity, "Enemy");
+            registry.addComponent<Weapon>(entity);
+            registry.addComponent<Health>(entity, 30, 30);
+        } else {
+            registry.addComponent<Tag>(entity, "BasicProjectile");
+            registry.addComponent<Projectile>(entity, Projectile{10.0f, 5.0f, 0});
+        }
+    }
+}
+
+template <typename Func> double measure(int reps, Func f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < reps; ++i) {
+        f();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / reps;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = (argc > 1) ? std::stoul(argv[1]) : 2000;
+    int reps = (argc > 2) ? std::stoi(argv[2]) : 1000;
+
+    GameEngine::Registry registry;
+    rtype::ecs::registerGameplaySnapshots(registry);
+    populate(registry, count);
+
+    std::vector<std::uint8_t> blob;
+    double t_snapshot = measure(reps, [&]() { registry.snapshot(blob); });
+    double t_restore = measure(reps, [&]() { registry.restore(blob); });
+
+    // Columns: operation, entities, microseconds, blob bytes
+    std::cout << "SNAPSHOT," << count << "," << t_snapshot << "," << blob.size() << std::endl;
+    std::cout << "RESTORE," << count << "," << t_restore << "," << blob.size() << std::endl;
+    return 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rtype::ecs {
+
+/// @brief Boxes packed as separate min/max coordinate arrays (SoA), the layout the overlap kernel reads
+class AabbBlock {
+  public:
+    void clear();
+
+    /// @brief Appends a box, its max corner is computed once here as x + width and y + height
+    void push(float x, float y, float width, float height);
+
+    std::size_t size() const {
+        return _minX.size();
+    }
+
+    const float* minX() const {
+        return _minX.data();
+    }
+
+    const float* minY() const {
+        return _minY.data();
+    }
+
+    const float* maxX() const {
+        return _maxX.data();
+    }
+
+    const float* maxY() const {
+        return _maxY.data();
+    }
+
+  private:
+    std::vector<float> _minX;
+    std::vector<float> _minY;
+    std::vector<float> _maxX;
+    std::vector<float> _maxY;
+};
+
+/// @brief Tests one box against up to 64 boxes of block, starting at first
+/// @return Bit k set when the box overlaps block box first + k, with the same strict comparisons and float results as
+/// CollisionSystem's scalar AABB test
+std::uint64_t overlapMask(const AabbBlock& block, std::size_t first, float x, float y, float width, float height);
+
+/// @brief Instruction set the kernel was compiled for: "avx", "sse" or "scalar"
+const char* overlapKernelIsa();
+
+} // namespace rtype::ecs
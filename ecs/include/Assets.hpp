@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rtype::ecs {
+
+/// @brief Interned texture name, compared as an integer
+using TextureId = std::uint16_t;
+
+/// @brief Id of an animation clip in AnimationClips
+using ClipId = std::uint16_t;
+
+/// @brief Process-wide interning of texture names
+/// @details Id 0 is the empty name. Ids are only meaningful inside one process, they are never sent over the network.
+class TextureTable {
+  public:
+    /// @brief Id of the name, registering it if needed
+    static TextureId intern(std::string_view name);
+
+    /// @brief Name of an interned id, empty for unknown ids
+    /// @details Lock-free, so renderers can call it for every sprite every frame.
+    static const std::string& name(TextureId id);
+};
+
+/// @brief Sprite indices played in order, shared by every Drawable using the clip
+struct AnimationClip {
+    std::string name;
+    std::vector<std::uint32_t> frames;
+};
+
+namespace clips {
+
+/// @brief Clips built into the library, a built-in clip's id is its definition order in AnimationClips
+inline constexpr ClipId None = 0;
+inline constexpr ClipId ShipIdle = 1;
+inline constexpr ClipId ShipUp = 2;
+inline constexpr ClipId ShipDown = 3;
+inline constexpr ClipId Explosion = 4;
+
+} // namespace clips
+
+/// @brief Process-wide library of animation clips, defined once and referenced by id from Drawable
+/// @details Clips are never changed or removed, so references returned by get() stay valid. Lookups and definitions
+/// are thread-safe.
+class AnimationClips {
+  public:
+    /// @brief Registers a clip and returns its id, or the id of the clip already defined under that name
+    static ClipId define(std::string_view name, std::vector<std::uint32_t> frames);
+
+    /// @brief Id of a clip if it was defined
+    static std::optional<ClipId> find(std::string_view name);
+
+    /// @brief Clip of an id, the empty None clip for unknown ids
+    static const AnimationClip& get(ClipId id);
+};
+
+} // namespace rtype::ecs
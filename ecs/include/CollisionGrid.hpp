@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rtype::ecs {
+
+/// @brief Uniform grid over the map bucketing boxes by the cells they overlap
+/// @details Boxes reaching past the map edges are clamped into the border cells, so nothing is ever dropped; the
+/// grid only costs more for crowds off-screen. Ids are caller-chosen, typically indices into a per-tick entity list.
+class CollisionGrid {
+  public:
+    CollisionGrid(float minX, float minY, float maxX, float maxY, float cellSize);
+
+    /// @brief Empties every cell, keeping their storage
+    void clear();
+
+    /// @brief Registers id in every cell overlapped by the box
+    void insert(std::uint32_t id, float x, float y, float width, float height);
+
+    /// @brief Calls visit(id) for each id registered in the cells overlapped by the box
+    /// @details An id spanning several of these cells is visited once per shared cell.
+    template <typename Func> void query(float x, float y, float width, float height, Func&& visit) const {
+        const CellRange range = cellsOf(x, y, width, height);
+        for (int row = range.minRow; row <= range.maxRow; ++row) {
+            for (int col = range.minCol; col <= range.maxCol; ++col) {
+                for (std::uint32_t id : _cells[static_cast<std::size_t>(row * _columns + col)]) {
+                    visit(id);
+                }
+            }
+        }
+    }
+
+    int columns() const {
+        return _columns;
+    }
+
+    int rows() const {
+        return _rows;
+    }
+
+  private:
+    struct CellRange {
+        int minCol;
+        int maxCol;
+        int minRow;
+        int maxRow;
+    };
+
+    CellRange cellsOf(float x, float y, float width, float height) const;
+    int cellOf(float value, float min, int count) const;
+
+    float _minX;
+    float _minY;
+    float _cellSize;
+    int _columns;
+    int _rows;
+    std::vector<std::vector<std::uint32_t>> _cells;
+};
+
+} // namespace rtype::ecs
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ComponentFamily.hpp"
+#include "Registry.hpp"
+
+namespace GameEngine {
+
+/// @brief Records structural changes made while iterating and applies them at sync points
+/// @details Entities get their handle right away through Registry::reserveEntity(), so components can be queued on
+/// them from any thread, and become valid when flush() materializes them. Additions, removals and destructions are
+/// then replayed in recording order; pending components live in per-type pools whose memory is reused from one flush
+/// to the next.
+class CommandBuffer {
+  public:
+    explicit CommandBuffer(Registry& registry) : _registry(registry) {
+    }
+
+    /// @brief Reserves a new entity, valid once flushed; its components can be queued with add()
+    entity_t create() {
+        const entity_t entity = _registry.reserveEntity();
+        _created.push_back(entity);
+        return entity;
+    }
+
+    /// @brief Queues the destruction of an entity
+    void destroy(entity_t entity) {
+        _commands.push_back({CommandType::Destroy, entity, 0, 0});
+    }
+
+    /// @brief Queues a component, constructed now and moved into the registry on flush
+    template <typename T, typename... Args> void add(entity_t entity, Args&&... args) {
+        auto& pool = poolOf<T>();
+        const std::size_t slot = pool.push(std::forward<Args>(args)...);
+        _commands.push_back({CommandType::Add, entity, rtype::ecs::ComponentFamily::id<T>(), slot});
+    }
+
+    /// @brief Queues the removal of a component
+    template <typename T> void remove(entity_t entity) {
+        poolOf<T>();
+        _commands.push_back({CommandType::Remove, entity, rtype::ecs::ComponentFamily::id<T>(), 0});
+    }
+
+    /// @brief Applies every pending command in recording order, commands on destroyed entities are dropped
+    /// @details Signal listeners may queue more commands meanwhile: they land in the spare storage swapped in for the
+    /// replay and run in a following round, until nothing is left. A flush() nested in a listener leaves them to the
+    /// outer one.
+    void flush() {
+        if (_flushing) {
+            return;
+        }
+        _flushing = true;
+        struct Done {
+            bool& flushing;
+            ~Done() {
+                flushing = false;
+            }
+        } done{_flushing};
+
+        while (!empty()) {
+            _replaying.swap(_commands);
+            _replayingCreated.swap(_created);
+            _replayPools.swap(_pools);
+            for (entity_t entity : _replayingCreated) {
+                _registry.materializeEntity(entity);
+            }
+            for (auto& pool : _replayPools) {
+                if (pool) {
+                    pool->reserve(_registry);
+                }
+            }
+            for (const auto& command : _replaying) {
+                switch (command.type) {
+                case CommandType::Destroy:
+                    _registry.destroyEntity(command.entity);
+                    break;
+                case CommandType::Add:
+                    _replayPools[command.family]->add(_registry, command.entity, command.slot);
+                    break;
+                case CommandType::Remove:
+                    _replayPools[command.family]->remove(_registry, command.entity);
+                    break;
+                }
+            }
+            _replaying.clear();
+            _replayingCreated.clear();
+            for (auto& pool : _replayPools) {
+                if (pool) {
+                    pool->clear();
+                }
+            }
+        }
+    }
+
+    /// @brief Moves every pending command to the end of target, keeping their order
+    void appendTo(CommandBuffer& target) {
+        target._created.insert(target._created.end(), _created.begin(), _created.end());
+        for (Command command : _commands) {
+            if (command.type == CommandType::Add) {
+                command.slot = _pools[command.family]->transfer(command.slot, target);
+            } else if (command.type == CommandType::Remove) {
+                _pools[command.family]->attach(target);
+            }
+            target._commands.push_back(command);
+        }
+        clear();
+    }
+
+    /// @brief Drops pending commands without applying them, reserved entities are never created
+    void clear() {
+        _commands.clear();
+        _created.clear();
+        for (auto& pool : _pools) {
+            if (pool) {
+                pool->clear();
+            }
+        }
+    }
+
+    bool empty() const {
+        return _commands.empty() && _created.empty();
+    }
+
+    /// @brief Pending commands, creations included
+    std::size_t size() const {
+        return _commands.size() + _created.size();
+    }
+
+  private:
+    enum class CommandType : std::uint8_t { Destroy, Add, Remove };
+
+    struct Command {
+        CommandType type;
+        entity_t entity;
+        std::size_t family;
+        std::size_t slot;
+    };
+
+    class IPendingPool {
+      public:
+        virtual ~IPendingPool() = default;
+        virtual void reserve(Registry& registry) = 0;
+        virtual void add(Registry& registry, entity_t entity, std::size_t slot) = 0;
+        virtual void remove(Registry& registry, entity_t entity) = 0;
+        virtual std::size_t transfer(std::size_t slot, CommandBuffer& target) = 0;
+        virtual void attach(CommandBuffer& target) = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename T> class PendingPool final : public IPendingPool {
+      public:
+        template <typename... Args> std::size_t push(Args&&... args) {
+            _values.emplace_back(std::forward<Args>(args)...);
+            return _values.size() - 1;
+        }
+
+        void reserve(Registry& registry) override {
+            if (!_values.empty()) {
+                registry.reserve<T>(_values.size());
+            }
+        }
+
+        void add(Registry& registry, entity_t entity, std::size_t slot) override {
+            if (registry.isValid(entity)) {
+                registry.addComponent<T>(entity, std::move(_values[slot]));
+            }
+        }
+
+        void remove(Registry& registry, entity_t entity) override {
+            registry.removeComponent<T>(entity);
+        }
+
+        std::size_t transfer(std::size_t slot, CommandBuffer& target) override {
+            return target.poolOf<T>().push(std::move(_values[slot]));
+        }
+
+        void attach(CommandBuffer& target) override {
+            target.poolOf<T>();
+        }
+
+        void clear() override {
+            _values.clear();
+        }
+
+      private:
+        std::vector<T> _values;
+    };
+
+    template <typename T> PendingPool<T>& poolOf() {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _pools.size()) {
+            _pools.resize(family + 1);
+        }
+        auto& pool = _pools[family];
+        if (!pool) {
+            pool = std::make_unique<PendingPool<T>>();
+        }
+        return static_cast<PendingPool<T>&>(*pool);
+    }
+
+    Registry& _registry;
+    std::vector<entity_t> _created;
+    std::vector<Command> _commands;
+    std::vector<std::unique_ptr<IPendingPool>> _pools;
+    // Storage of the round being replayed by flush(), swapped with the live one
+    std::vector<entity_t> _replayingCreated;
+    std::vector<Command> _replaying;
+    std::vector<std::unique_ptr<IPendingPool>> _replayPools;
+    bool _flushing = false;
+};
+
+} // namespace GameEngine
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace rtype::ecs {
+
+/// @brief Dense per-type component ids, assigned on first use and stable for the process lifetime
+class ComponentFamily {
+  public:
+    template <typename Component> static std::size_t id() {
+        return idOf<std::remove_cv_t<std::remove_reference_t<Component>>>();
+    }
+
+  private:
+    template <typename Component> static std::size_t idOf() {
+        static const std::size_t value = _counter.fetch_add(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    static inline std::atomic<std::size_t> _counter{0};
+};
+
+} // namespace rtype::ecs
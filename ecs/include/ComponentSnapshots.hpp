@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Registry.hpp"
+#include "Snapshot.hpp"
+#include "components/CollisionLayer.hpp"
+#include "components/EnemySpawner.hpp"
+#include "components/GameRulesComponent.hpp"
+#include "components/Health.hpp"
+#include "components/HitBox.hpp"
+#include "components/HitFlash.hpp"
+#include "components/InvincibilityTimer.hpp"
+#include "components/Lives.hpp"
+#include "components/MapBounds.hpp"
+#include "components/MovementPattern.hpp"
+#include "components/NetworkId.hpp"
+#include "components/Parent.hpp"
+#include "components/PlayerName.hpp"
+#include "components/Position.hpp"
+#include "components/PowerUpType.hpp"
+#include "components/Projectile.hpp"
+#include "components/Score.hpp"
+#include "components/ScreenMode.hpp"
+#include "components/SpawnEffect.hpp"
+#include "components/StageCleared.hpp"
+#include "components/Tag.hpp"
+#include "components/Velocity.hpp"
+#include "components/Weapon.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Tags are written by name, only known tags keep the same id from one process to the next
+template <> struct SnapshotTraits<component::Tag> {
+    static constexpr bool custom = true;
+
+    static void save(SnapshotWriter& out, const component::Tag& tag) {
+        out.writeString(tag.name());
+    }
+
+    static component::Tag load(SnapshotReader& in) {
+        return component::Tag(TagTable::intern(in.readString()));
+    }
+};
+
+template <> struct SnapshotTraits<component::PlayerName> {
+    static constexpr bool custom = true;
+
+    static void save(SnapshotWriter& out, const component::PlayerName& name) {
+        out.writeString(name.name);
+    }
+
+    static component::PlayerName load(SnapshotReader& in) {
+        return component::PlayerName(in.readString());
+    }
+};
+
+/// @brief Weapon writes its projectile tag by name like Tag, every other field is written as is
+template <> struct SnapshotTraits<component::Weapon> {
+    static constexpr bool custom = true;
+
+    static void save(SnapshotWriter& out, const component::Weapon& weapon) {
+        out.write(weapon.isShooting);
+        out.write(weapon.autoFire);
+        out.write(weapon.timeSinceLastFire);
+        out.write(weapon.fireRate);
+        out.write(weapon.damage);
+        out.write(weapon.projectileLifetime);
+        out.write(weapon.projectileSpeed);
+        out.write(weapon.directionX);
+        out.write(weapon.directionY);
+        out.write(weapon.spawnOffsetX);
+        out.write(weapon.spawnOffsetY);
+        out.writeString(TagTable::name(weapon.projectileTag));
+        out.write(weapon.chargeLevel);
+        out.write(weapon.projectilePattern);
+        out.write(weapon.projectileAmplitude);
+        out.write(weapon.projectileFrequency);
+        out.write(weapon.projectileWidth);
+        out.write(weapon.projectileHeight);
+        out.write(weapon.ignoreScroll);
+    }
+
+    static component::Weapon load(SnapshotReader& in) {
+        component::Weapon weapon;
+        weapon.isShooting = in.read<bool>();
+        weapon.autoFire = in.read<bool>();
+        weapon.timeSinceLastFire = in.read<float>();
+        weapon.fireRate = in.read<float>();
+        weapon.damage = in.read<float>();
+        weapon.projectileLifetime = in.read<float>();
+        weapon.projectileSpeed = in.read<float>();
+        weapon.directionX = in.read<float>();
+        weapon.directionY = in.read<float>();
+        weapon.spawnOffsetX = in.read<float>();
+        weapon.spawnOffsetY = in.read<float>();
+        weapon.projectileTag = TagTable::intern(in.readString());
+        weapon.chargeLevel = in.read<int>();
+        weapon.projectilePattern = in.read<component::MovementPatternType>();
+        weapon.projectileAmplitude = in.read<float>();
+        weapon.projectileFrequency = in.read<float>();
+        weapon.projectileWidth = in.read<float>();
+        weapon.projectileHeight = in.read<float>();
+        weapon.ignoreScroll = in.read<bool>();
+        return weapon;
+    }
+};
+
+/// @brief Registers every component making up the server-side game state for Registry::snapshot()
+inline void registerGameplaySnapshots(GameEngine::Registry& registry) {
+    using namespace component;
+    registry.registerSnapshot<Position>();
+    registry.registerSnapshot<Velocity>();
+    registry.registerSnapshot<Health>();
+    registry.registerSnapshot<HitBox>();
+    registry.registerSnapshot<Collidable>();
+    registry.registerSnapshot<Weapon>();
+    registry.registerSnapshot<Tag>();
+    registry.registerSnapshot<NetworkId>();
+    registry.registerSnapshot<PlayerName>();
+    registry.registerSnapshot<MovementPattern>();
+    registry.registerSnapshot<Projectile>();
+    registry.registerSnapshot<Parent>();
+    registry.registerSnapshot<Lives>();
+    registry.registerSnapshot<Score>();
+    registry.registerSnapshot<ScoreEvent>();
+    registry.registerSnapshot<ScreenMode>();
+    registry.registerSnapshot<HitFlash>();
+    registry.registerSnapshot<InvincibilityTimer>();
+    registry.registerSnapshot<SpawnEffect>();
+    registry.registerSnapshot<PowerUpType>();
+    registry.registerSnapshot<StageCleared>();
+    registry.registerSnapshot<MapBounds>();
+    registry.registerSnapshot<EnemySpawner>();
+    registry.registerSnapshot<GameRulesComponent>();
+}
+
+} // namespace rtype::ecs
@@ -1,9 +1,30 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace rtype::ecs {
 
 using Entity = std::size_t;
 
+/// @brief Entity handles pack a recyclable slot index (low half) and the slot generation (high half)
+namespace entity {
+
+inline constexpr std::size_t INDEX_BITS = sizeof(Entity) * 4;
+inline constexpr Entity INDEX_MASK = (Entity{1} << INDEX_BITS) - 1;
+
+constexpr std::size_t index(Entity handle) {
+    return handle & INDEX_MASK;
+}
+
+constexpr std::uint32_t generation(Entity handle) {
+    return static_cast<std::uint32_t>(handle >> INDEX_BITS);
+}
+
+constexpr Entity make(std::size_t index, std::uint32_t generation) {
+    return (static_cast<Entity>(generation) << INDEX_BITS) | (index & INDEX_MASK);
+}
+
+} // namespace entity
+
 } // namespace rtype::ecs
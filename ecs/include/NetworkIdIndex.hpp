@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include "Registry.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Maps network ids to local entities in O(1), kept up to date by the registry's NetworkId signals
+/// @details Adding, destroying, clear() and restore() all go through the signals, so the index survives registry
+/// resets. A NetworkId value must not be rewritten in place once added. When several entities share a network id,
+/// the latest one wins.
+class NetworkIdIndex {
+  public:
+    /// @brief Connects to the registry signals and indexes the entities already carrying a NetworkId
+    explicit NetworkIdIndex(GameEngine::Registry& registry);
+    ~NetworkIdIndex();
+
+    NetworkIdIndex(const NetworkIdIndex&) = delete;
+    NetworkIdIndex& operator=(const NetworkIdIndex&) = delete;
+
+    /// @brief Index stored in the registry context, created on first use
+    static NetworkIdIndex& of(GameEngine::Registry& registry);
+
+    /// @brief Local entity carrying the network id, nullopt if none
+    std::optional<GameEngine::entity_t> find(std::uint32_t networkId) const;
+
+    std::size_t size() const {
+        return _entities.size();
+    }
+
+  private:
+    GameEngine::Registry& _registry;
+    GameEngine::Registry::Connection _construct;
+    GameEngine::Registry::Connection _destroy;
+    std::unordered_map<std::uint32_t, GameEngine::entity_t> _entities;
+};
+
+} // namespace rtype::ecs
@@ -1,119 +1,440 @@
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <atomic>
+#include <functional>
 #include <memory>
-#include <typeindex>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
-#include "SparseArray.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include "ComponentFamily.hpp"
+#include "Snapshot.hpp"
+#include "SparseSet.hpp"
+#include "SystemProfiler.hpp"
 #include "interfaces/ecs/IEntityRegistry.hpp"
+#include "interfaces/ecs/IComponentStorage.hpp"
 
 namespace GameEngine {
 
-/// @brief Custom ECS Registry using SparseArray for component storage
+class CommandBuffer;
+class ThreadPool;
+
+/// @brief Lists the non-owned components of a group, e.g. registry.group<HitBox, Collidable>(get_t<Position>{})
+template <typename... Components> struct get_t {
+    explicit constexpr get_t() = default;
+};
+
+/// @brief Custom ECS Registry using packed SparseSet storages for components, indexed by component family id
 class Registry : public IEntityRegistry {
   public:
-    Registry() : _nextEntity(0) {
-    }
-    ~Registry() override = default;
+    /// @brief Smallest chunk handed to a thread by each_parallel unless the caller asks otherwise
+    static constexpr std::size_t DefaultMinChunk = 256;
+
+    Registry();
+    ~Registry() override;
 
     /// @brief Creates a new entity
     entity_t createEntity() override;
 
+    /// @brief Hands out the handle of an entity that materializeEntity() creates later
+    /// @details Safe from several threads at once while nothing else changes the registry structurally, which is how
+    /// CommandBuffer::create() runs inside each_parallel chunks and parallel stages. The handle is not valid yet.
+    entity_t reserveEntity();
+
+    /// @brief Makes a handle from reserveEntity() valid, a no-op for handles reserved before clear()
+    void materializeEntity(entity_t entity);
+
     /// @brief Destroys an entity and its components
     void destroyEntity(entity_t entity) override;
 
     /// @brief Checks if an entity is valid
     bool isValid(entity_t entity) const override;
 
-    /// @brief Clears all entities
+    /// @brief Clears all entities, component storages keep their capacity and context values are kept
     void clear() override;
 
+    /// @brief Bytes reserved by all component storages
+    std::size_t componentMemoryUsage() const;
+
+    /// @brief Deferred structural changes, applied by SystemManager between systems
+    CommandBuffer& commands();
+
+    /// @brief Routes commands() on the calling thread to buffer, nullptr restores the registry's own buffer
+    /// @return The buffer previously bound on this thread, nullptr if none
+    CommandBuffer* bindThreadCommands(CommandBuffer* buffer);
+
+    /// @brief Threads used by parallel iteration and system stages, calling thread included, 0 for the hardware count
+    void setThreadCount(std::size_t count);
+
+    /// @brief Threads used by parallel iteration and system stages, calling thread included
+    std::size_t threadCount() const;
+
+    /// @brief Worker pool shared by SystemManager stages and each_parallel, created on first use
+    ThreadPool& threadPool();
+
+    /// @brief Reserves room for additional components of type T
+    template <typename T> void reserve(std::size_t additional) {
+        auto& storage = getOrCreateStorage<T>();
+        storage.reserve(storage.size() + additional);
+    }
+
     /// @brief Adds a component to an entity
+    /// @throws std::runtime_error if the entity was destroyed, a stale handle never writes to the slot's new owner
     template <typename T, typename... Args> T& addComponent(entity_t entity, Args&&... args) {
+        if (!isValid(entity)) {
+            throw std::runtime_error("Cannot add a component to a destroyed entity");
+        }
         auto& storage = getOrCreateStorage<T>();
+        const bool added = !storage.contains(entity);
         storage.emplace_at(entity, std::forward<Args>(args)...);
-        return *storage[entity];
+        storage.touch(entity, _changeTick);
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        notifyGroupsConstruct(family, entity);
+        if (added) {
+            emit(family, &Signals::construct, entity);
+        }
+        return storage.get(entity);
+    }
+
+    /// @brief Listener called with the registry and the entity whose component was just added or is about to go
+    using ComponentListener = std::function<void(Registry&, entity_t)>;
+
+    /// @brief Handle of a connected listener, used to disconnect it
+    using Connection = std::size_t;
+
+    /// @brief Calls listener after a component of type T is added to an entity that did not have one
+    /// @details Listeners must not change the registry structurally, they queue work or use commands() instead.
+    /// Commands queued while CommandBuffer::flush() runs are replayed by that same flush, after the current round.
+    template <typename T> Connection onConstruct(ComponentListener listener) {
+        return connect(rtype::ecs::ComponentFamily::id<T>(), &Signals::construct, std::move(listener));
+    }
+
+    /// @brief Calls listener before a component of type T is removed, destroyed with its entity or cleared
+    /// @details The component can still be read from the listener.
+    template <typename T> Connection onDestroy(ComponentListener listener) {
+        return connect(rtype::ecs::ComponentFamily::id<T>(), &Signals::destroy, std::move(listener));
+    }
+
+    /// @brief Disconnects a listener returned by onConstruct or onDestroy
+    void disconnect(Connection connection);
+
+    /// @brief Current change tick, stamped on components by addComponent, patch and markChanged
+    std::uint32_t changeTick() const {
+        return _changeTick;
+    }
+
+    /// @brief Starts a new change tick and returns it, consumers keep it to later ask for changes since that point
+    std::uint32_t advanceChangeTick() {
+        return ++_changeTick;
+    }
+
+    /// @brief Gets a component for writing and stamps it as changed
+    /// @throws std::runtime_error if component is missing
+    template <typename T> T& patch(entity_t entity) {
+        T& component = getComponent<T>(entity);
+        getOrCreateStorage<T>().touch(entity, _changeTick);
+        return component;
+    }
+
+    /// @brief Stamps a component written through a view or a reference as changed, no-op if the entity lacks it
+    template <typename T> void markChanged(entity_t entity) {
+        auto& storage = getOrCreateStorage<T>();
+        if (storage.contains(entity)) {
+            storage.touch(entity, _changeTick);
+        }
+    }
+
+    /// @brief Checks if the entity's component was added or written at or after the given tick
+    template <typename T> bool changedSince(entity_t entity, std::uint32_t tick) const {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _componentArrays.size() || !_componentArrays[family]) {
+            return false;
+        }
+        const auto& storage = static_cast<const rtype::ecs::SparseSet<T>&>(*_componentArrays[family]);
+        return storage.contains(entity) && storage.version(entity) >= tick;
+    }
+
+    /// @brief Calls func(entity, component) for every component of type T added or written at or after the tick
+    template <typename T, typename Func> void eachChanged(std::uint32_t tick, Func&& func) {
+        auto& storage = getOrCreateStorage<T>();
+        const auto& versions = storage.versions();
+        for (std::size_t pos = versions.size(); pos > 0; pos = std::min(pos - 1, versions.size())) {
+            if (versions[pos - 1] >= tick) {
+                const entity_t entity = storage.entity_at(pos - 1);
+                func(entity, storage.get(entity));
+            }
+        }
     }
 
     /// @brief Gets a component from an entity
     /// @throws std::runtime_error if component is missing
     template <typename T> T& getComponent(entity_t entity) {
         auto& storage = getOrCreateStorage<T>();
-        if (!storage[entity].has_value()) {
+        if (!storage.contains(entity)) {
             throw std::runtime_error("Entity does not have the requested component");
         }
-        return *storage[entity];
+        return storage.get(entity);
     }
 
     /// @brief Removes a component from an entity
     template <typename T> void removeComponent(entity_t entity) {
         auto& storage = getOrCreateStorage<T>();
-        storage.erase(entity);
+        if (storage.contains(entity)) {
+            const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+            emit(family, &Signals::destroy, entity);
+            notifyGroupsDestroy(family, entity);
+            storage.erase(entity);
+        }
     }
 
     /// @brief Checks if an entity has a component
     template <typename T> bool hasComponent(entity_t entity) const {
-        auto it = _componentArrays.find(std::type_index(typeid(T)));
-        if (it == _componentArrays.end()) {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _componentArrays.size() || !_componentArrays[family]) {
             return false;
         }
-        auto storage = std::static_pointer_cast<rtype::ecs::SparseArray<T>>(it->second);
-        return storage->operator[](entity).has_value();
+        return static_cast<const rtype::ecs::SparseSet<T>&>(*_componentArrays[family]).contains(entity);
     }
 
-    /// @brief Creates a view for iterating entities with specific components
+    /// @brief Stores the registry-wide value of type T (rules, bounds, spawner state), replacing the current one
+    /// @details Context values belong to no entity and survive clear(). They share the component family ids, so the
+    /// SystemAccess declarations of a system on T cover the context value of type T as well.
+    template <typename T, typename... Args> T& emplaceContext(Args&&... args) {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _context.size()) {
+            _context.resize(family + 1);
+        }
+        auto value = std::make_unique<ContextValue<T>>(std::forward<Args>(args)...);
+        T& result = value->value;
+        _context[family] = std::move(value);
+        return result;
+    }
+
+    /// @brief Context value of type T, nullptr if none was emplaced
+    template <typename T> T* findContext() {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _context.size() || !_context[family]) {
+            return nullptr;
+        }
+        return &static_cast<ContextValue<T>&>(*_context[family]).value;
+    }
+
+    template <typename T> const T* findContext() const {
+        return const_cast<Registry*>(this)->findContext<T>();
+    }
+
+    /// @brief Context value of type T
+    /// @throws std::runtime_error if none was emplaced
+    template <typename T> T& context() {
+        T* value = findContext<T>();
+        if (!value) {
+            throw std::runtime_error("Registry has no context value of the requested type");
+        }
+        return *value;
+    }
+
+    /// @brief Checks if a context value of type T was emplaced
+    template <typename T> bool hasContext() const {
+        return findContext<T>() != nullptr;
+    }
+
+    /// @brief Destroys the context value of type T, no-op if there is none
+    template <typename T> void eraseContext() {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family < _context.size()) {
+            _context[family].reset();
+        }
+    }
+
+    /// @brief Includes the components and the context value of type T in snapshot() and restore()
+    /// @details Trivially copyable components are copied as raw bytes, others need a SnapshotTraits specialization.
+    template <typename T> void registerSnapshot() {
+        static_assert(std::is_trivially_copyable_v<T> || rtype::ecs::SnapshotTraits<T>::custom,
+                      "Component needs a SnapshotTraits specialization to be snapshotted");
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        for (const auto& type : _snapshotTypes) {
+            if (type.family == family) {
+                return;
+            }
+        }
+        _snapshotTypes.push_back(
+            {family, typeid(T).name(), static_cast<std::uint32_t>(sizeof(T)), &saveStorage<T>, &loadStorage<T>});
+    }
+
+    /// @brief Writes the entity metadata and every registered component storage into out, replacing its content
+    /// @details out keeps its capacity, so taking snapshots into the same buffer does not allocate once warm.
+    void snapshot(std::vector<std::uint8_t>& out) const;
+
+    /// @brief Replaces the whole registry state with a blob produced by snapshot()
+    /// @details Entities keep their handles. Components are added back through addComponent, so groups, signals and
+    /// change ticks see them as new. The context value of a registered type is replaced or erased to match the blob.
+    /// Blocks of types not registered here are skipped. Restoring is not transparent to signal listeners: the
+    /// clear() it starts with reports every component as destroyed, then the restored ones are reported as added.
+    /// @throws std::runtime_error if the blob is malformed, the registry is then left without entities
+    void restore(const std::vector<std::uint8_t>& blob);
+
+    /// @brief Lazy view over the entities owning all requested components
+    /// @details Walks the smallest requested pool backwards and probes the other pools, nothing is allocated. Adding
+    /// entities or removing the current one while iterating is safe; other removals must be deferred.
     template <typename... Components> class View {
       public:
-        View(Registry& registry) : _registry(registry) {
-            for (entity_t entity : _registry._validEntities) {
-                if (_registry.hasAllComponents<Components...>(entity)) {
-                    _entities.push_back(entity);
+        class iterator {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = entity_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const entity_t*;
+            using reference = entity_t;
+
+            iterator(const View* view, std::size_t pos) : _view(view), _pos(pos) {
+                skipMismatches();
+            }
+
+            entity_t operator*() const {
+                return (*_view->_candidates)[_pos - 1];
+            }
+
+            iterator& operator++() {
+                _pos = std::min(_pos - 1, _view->_candidates->size());
+                skipMismatches();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const iterator& other) const {
+                return _pos == other._pos;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return _pos != other._pos;
+            }
+
+          private:
+            void skipMismatches() {
+                while (_pos > 0 && !_view->containsAll((*_view->_candidates)[_pos - 1])) {
+                    _pos = std::min(_pos - 1, _view->_candidates->size());
                 }
             }
+
+            const View* _view;
+            std::size_t _pos;
+        };
+
+        explicit View(Registry& registry)
+            : _registry(&registry), _storages(&registry.getOrCreateStorage<Components>()...) {
+            std::apply(
+                [this](auto*... storage) {
+                    (selectCandidates(storage->entities()), ...);
+                },
+                _storages);
         }
 
         /// @brief Iterate over entities with callback (passes entity ID first, then components)
+        /// @details Empty components only filter: they are tested for membership and not passed to func.
         template <typename Func> void each(Func&& func) {
-            for (entity_t entity : _entities) {
-                func(entity, _registry.getComponent<Components>(entity)...);
+            if constexpr (SystemProfiler::Enabled) {
+                SystemProfiler::addVisited(_candidates->size());
+            }
+            for (std::size_t pos = _candidates->size(); pos > 0; pos = std::min(pos - 1, _candidates->size())) {
+                const entity_t entity = (*_candidates)[pos - 1];
+                if (containsAll(entity)) {
+                    invoke(func, entity);
+                }
             }
         }
 
+        /// @brief Iterates in chunks of at least minChunk entities spread over the registry thread pool
+        /// @details func may only touch the components of the entity it is given. Structural changes must go through
+        /// registry.commands(), which records into per-chunk buffers appended to the caller's buffer in chunk order.
+        /// commands().create() is safe there too: it only reserves a handle, the entity exists once the caller flushes.
+        template <typename Func> void each_parallel(Func&& func, std::size_t minChunk = DefaultMinChunk) {
+            const std::vector<entity_t>& candidates = *_candidates;
+            const std::size_t count = candidates.size();
+            const std::size_t chunks = _registry->chunkCount(count, minChunk);
+            if (chunks <= 1) {
+                each(func);
+                return;
+            }
+            if constexpr (SystemProfiler::Enabled) {
+                SystemProfiler::addVisited(count);
+            }
+            _registry->runChunks(chunks, [&](std::size_t chunk) {
+                const std::size_t first = count * chunk / chunks;
+                for (std::size_t pos = count * (chunk + 1) / chunks; pos > first; --pos) {
+                    const entity_t entity = candidates[pos - 1];
+                    if (containsAll(entity)) {
+                        invoke(func, entity);
+                    }
+                }
+            });
+        }
+
         /// @brief Get a specific component from an entity in this view
+        /// @throws std::runtime_error if component is missing
         template <typename T> T& get(entity_t entity) {
-            return _registry.getComponent<T>(entity);
+            auto& pool = storage<T>();
+            if (!pool.contains(entity)) {
+                throw std::runtime_error("Entity does not have the requested component");
+            }
+            return pool.get(entity);
         }
 
-        /// @brief Get list of entities
-        const std::vector<entity_t>& entities() const {
-            return _entities;
+        /// @brief Upper bound of the number of entities, the size of the smallest pool
+        std::size_t sizeHint() const {
+            return _candidates->size();
+        }
+
+        /// @brief Checks if no entity matches
+        bool empty() const {
+            return begin() == end();
         }
 
         /// @brief Begin iterator for range-based for loop
-        auto begin() {
-            return _entities.begin();
+        iterator begin() const {
+            return iterator(this, _candidates->size());
         }
 
         /// @brief End iterator for range-based for loop
-        auto end() {
-            return _entities.end();
+        iterator end() const {
+            return iterator(this, 0);
         }
 
-        /// @brief Const begin iterator
-        auto begin() const {
-            return _entities.begin();
+      private:
+        template <typename T> rtype::ecs::SparseSet<T>& storage() const {
+            return *std::get<rtype::ecs::SparseSet<T>*>(_storages);
         }
 
-        /// @brief Const end iterator
-        auto end() const {
-            return _entities.end();
+        void selectCandidates(const std::vector<entity_t>& entities) {
+            if (_candidates == nullptr || entities.size() < _candidates->size()) {
+                _candidates = &entities;
+            }
         }
 
-      private:
-        Registry& _registry;
-        std::vector<entity_t> _entities;
+        bool containsAll(entity_t entity) const {
+            return (storage<Components>().contains(entity) && ...);
+        }
+
+        template <typename Func> void invoke(Func& func, entity_t entity) const {
+            std::apply(func,
+                       std::tuple_cat(std::tuple<entity_t>(entity), componentArg(storage<Components>(), entity)...));
+        }
+
+        Registry* _registry;
+        std::tuple<rtype::ecs::SparseSet<Components>*...> _storages;
+        const std::vector<entity_t>* _candidates = nullptr;
     };
 
     /// @brief Creates a view for iterating entities with specific components
@@ -122,27 +443,649 @@ class Registry : public IEntityRegistry {
     }
 
   private:
-    entity_t _nextEntity;
-    std::unordered_set<entity_t> _validEntities;
-    std::unordered_map<std::type_index, std::shared_ptr<void>> _componentArrays;
+    /// @brief Told about component additions and removals: groups keep their members packed at the front of the owned
+    /// storages, persistent queries update their member lists
+    class IGroupHandler {
+      public:
+        virtual ~IGroupHandler() = default;
+        virtual void onConstruct(entity_t entity) = 0;
+        virtual void onDestroy(entity_t entity) = 0;
+        virtual void reset() = 0;
+    };
 
-    /// @brief Gets or creates component storage for type T
-    template <typename T> rtype::ecs::SparseArray<T>& getOrCreateStorage() {
-        auto typeIndex = std::type_index(typeid(T));
-        auto it = _componentArrays.find(typeIndex);
+    template <typename Get, typename... Owned> class GroupHandler;
+
+    template <typename... Get, typename... Owned>
+    class GroupHandler<get_t<Get...>, Owned...> final : public IGroupHandler {
+      public:
+        GroupHandler(rtype::ecs::SparseSet<Owned>*... owned, rtype::ecs::SparseSet<Get>*... get)
+            : _owned(owned...), _get(get...) {
+        }
+
+        void onConstruct(entity_t entity) override {
+            if (contains(entity) || !hasAll(entity)) {
+                return;
+            }
+            std::apply(
+                [this, entity](auto*... storage) {
+                    (storage->swap_at(storage->index_of(entity), _length), ...);
+                },
+                _owned);
+            ++_length;
+        }
+
+        void onDestroy(entity_t entity) override {
+            if (!contains(entity)) {
+                return;
+            }
+            --_length;
+            std::apply(
+                [this, entity](auto*... storage) {
+                    (storage->swap_at(storage->index_of(entity), _length), ...);
+                },
+                _owned);
+        }
+
+        void reset() override {
+            _length = 0;
+        }
+
+        bool contains(entity_t entity) const {
+            return std::get<0>(_owned)->index_of(entity) < _length;
+        }
+
+        bool hasAll(entity_t entity) const {
+            return std::apply([entity](auto*... storage) { return (storage->contains(entity) && ...); }, _owned) &&
+                   std::apply([entity](auto*... storage) { return (storage->contains(entity) && ...); }, _get);
+        }
+
+        std::size_t size() const {
+            return _length;
+        }
+
+        template <typename T> rtype::ecs::SparseSet<T>& owned() const {
+            return *std::get<rtype::ecs::SparseSet<T>*>(_owned);
+        }
+
+        template <typename T> rtype::ecs::SparseSet<T>& get() const {
+            return *std::get<rtype::ecs::SparseSet<T>*>(_get);
+        }
+
+        entity_t entityAt(std::size_t pos) const {
+            return std::get<0>(_owned)->entity_at(pos);
+        }
+
+      private:
+        std::tuple<rtype::ecs::SparseSet<Owned>*...> _owned;
+        std::tuple<rtype::ecs::SparseSet<Get>*...> _get;
+        std::size_t _length = 0;
+    };
+
+  public:
+    /// @brief Owning group: the owned storages keep the members packed first and in the same order
+    /// @details Joined iteration walks the owned arrays linearly, non-owned components are probed per entity. Each
+    /// storage can be owned by a single group. Adding owned components to other entities while iterating a view led
+    /// by an owned storage moves slots around and must be deferred.
+    template <typename Get, typename... Owned> class Group;
+
+    template <typename... Get, typename... Owned> class Group<get_t<Get...>, Owned...> {
+      public:
+        using Handler = GroupHandler<get_t<Get...>, Owned...>;
+
+        Group(Registry& registry, Handler& handler) : _registry(registry), _handler(handler) {
+        }
+
+        /// @brief Iterate over members with callback (entity first, then owned components, then non-owned ones)
+        /// @details Empty components are not passed to func, as with views.
+        template <typename Func> void each(Func&& func) {
+            if constexpr (SystemProfiler::Enabled) {
+                SystemProfiler::addVisited(_handler.size());
+            }
+            for (std::size_t pos = _handler.size(); pos > 0; pos = std::min(pos - 1, _handler.size())) {
+                invoke(func, pos - 1);
+            }
+        }
+
+        /// @brief Iterates in chunks of at least minChunk members spread over the registry thread pool
+        /// @details Same contract as View::each_parallel: per-entity work only, structural changes (creations included)
+        /// through commands().
+        template <typename Func> void each_parallel(Func&& func, std::size_t minChunk = DefaultMinChunk) {
+            const std::size_t count = _handler.size();
+            const std::size_t chunks = _registry.chunkCount(count, minChunk);
+            if (chunks <= 1) {
+                each(func);
+                return;
+            }
+            if constexpr (SystemProfiler::Enabled) {
+                SystemProfiler::addVisited(count);
+            }
+            _registry.runChunks(chunks, [&](std::size_t chunk) {
+                const std::size_t first = count * chunk / chunks;
+                for (std::size_t pos = count * (chunk + 1) / chunks; pos > first; --pos) {
+                    invoke(func, pos - 1);
+                }
+            });
+        }
+
+        /// @brief Checks if the entity is a member of the group
+        bool contains(entity_t entity) const {
+            return _handler.contains(entity);
+        }
+
+        /// @brief Number of members
+        std::size_t size() const {
+            return _handler.size();
+        }
+
+        /// @brief Members in packed order, valid until the next structural change
+        const entity_t* data() const {
+            return _handler.template owned<std::tuple_element_t<0, std::tuple<Owned...>>>().entities().data();
+        }
+
+      private:
+        template <typename Func> void invoke(Func& func, std::size_t pos) const {
+            const entity_t entity = _handler.entityAt(pos);
+            std::apply(func, std::tuple_cat(std::tuple<entity_t>(entity),
+                                            componentArgAt(_handler.template owned<Owned>(), pos)...,
+                                            componentArg(_handler.template get<Get>(), entity)...));
+        }
+
+        Registry& _registry;
+        Handler& _handler;
+    };
+
+    /// @brief Gets or creates the owning group over Owned, filtered on the Get components
+    /// @throws std::logic_error if one of the owned storages already belongs to another group
+    template <typename... Owned, typename... Get>
+    Group<get_t<Get...>, Owned...> group(get_t<Get...> = get_t<Get...>{}) {
+        static_assert(sizeof...(Owned) > 0, "A group must own at least one component type");
+        using Handler = GroupHandler<get_t<Get...>, Owned...>;
+
+        const std::size_t lead = rtype::ecs::ComponentFamily::id<std::tuple_element_t<0, std::tuple<Owned...>>>();
+        if (lead < _groupOwners.size() && _groupOwners[lead] != nullptr) {
+            if (auto* handler = dynamic_cast<Handler*>(_groupOwners[lead])) {
+                return Group<get_t<Get...>, Owned...>(*this, *handler);
+            }
+        }
+        for (std::size_t family : {rtype::ecs::ComponentFamily::id<Owned>()...}) {
+            if (family < _groupOwners.size() && _groupOwners[family] != nullptr) {
+                throw std::logic_error("Component storage is already owned by another group");
+            }
+        }
 
-        if (it == _componentArrays.end()) {
-            auto storage = std::make_shared<rtype::ecs::SparseArray<T>>();
-            _componentArrays[typeIndex] = storage;
-            return *storage;
+        auto handler = std::make_unique<Handler>(&getOrCreateStorage<Owned>()..., &getOrCreateStorage<Get>()...);
+        Handler& ref = *handler;
+        for (std::size_t family : {rtype::ecs::ComponentFamily::id<Owned>()...}) {
+            listenersOf(family).push_back(&ref);
+            _groupOwners[family] = &ref;
         }
+        (listenersOf(rtype::ecs::ComponentFamily::id<Get>()).push_back(&ref), ...);
+        _groups.push_back(std::move(handler));
 
-        return *std::static_pointer_cast<rtype::ecs::SparseArray<T>>(it->second);
+        const auto& candidates = ref.template owned<std::tuple_element_t<0, std::tuple<Owned...>>>().entities();
+        for (std::size_t pos = 0; pos < candidates.size(); ++pos) {
+            ref.onConstruct(candidates[pos]);
+        }
+        return Group<get_t<Get...>, Owned...>(*this, ref);
+    }
+
+    /// @brief Cost counters of a persistent query, to spot the hot ones
+    struct QueryStats {
+        std::string name;
+        std::size_t size = 0;      ///< Entities currently matching
+        std::uint64_t runs = 0;    ///< Iterations started, each() or range-for
+        std::uint64_t visited = 0; ///< Entities walked over all runs
+        std::uint64_t updates = 0; ///< Entities that joined or left the query
+    };
+
+  private:
+    class IQueryHandler : public IGroupHandler {
+      public:
+        virtual QueryStats stats() const = 0;
+    };
+
+    /// @brief Member list of a persistent query, updated from the same notifications as groups
+    template <typename... Components> class QueryHandler final : public IQueryHandler {
+      public:
+        QueryHandler(std::string name, rtype::ecs::SparseSet<Components>*... storages)
+            : _name(std::move(name)), _storages(storages...) {
+        }
+
+        void onConstruct(entity_t entity) override {
+            if (!_members.contains(entity) && (storage<Components>().contains(entity) && ...)) {
+                _members.emplace_at(entity);
+                _updates.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void onDestroy(entity_t entity) override {
+            if (_members.contains(entity)) {
+                _members.erase(entity);
+                _updates.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void reset() override {
+            _members.clear();
+        }
+
+        QueryStats stats() const override {
+            return {_name, _members.size(), _runs.load(std::memory_order_relaxed),
+                    _visited.load(std::memory_order_relaxed), _updates.load(std::memory_order_relaxed)};
+        }
+
+        /// @brief Counts one run over the current members
+        void record() {
+            _runs.fetch_add(1, std::memory_order_relaxed);
+            _visited.fetch_add(_members.size(), std::memory_order_relaxed);
+            if constexpr (SystemProfiler::Enabled) {
+                SystemProfiler::addVisited(_members.size());
+            }
+        }
+
+        const std::vector<entity_t>& entities() const {
+            return _members.entities();
+        }
+
+        bool contains(entity_t entity) const {
+            return _members.contains(entity);
+        }
+
+        template <typename T> rtype::ecs::SparseSet<T>& storage() const {
+            return *std::get<rtype::ecs::SparseSet<T>*>(_storages);
+        }
+
+      private:
+        struct Member {};
+
+        std::string _name;
+        std::tuple<rtype::ecs::SparseSet<Components>*...> _storages;
+        rtype::ecs::SparseSet<Member> _members;
+        std::atomic<std::uint64_t> _runs{0};
+        std::atomic<std::uint64_t> _visited{0};
+        std::atomic<std::uint64_t> _updates{0};
+    };
+
+  public:
+    /// @brief Persistent query: the entities owning all requested components, kept in a list updated incrementally
+    /// @details Iteration walks the list without probing any pool, unlike a view. Same safety rules as views: adding
+    /// entities or removing the current one while iterating is safe, other removals must be deferred.
+    template <typename... Components> class Query {
+      public:
+        using Handler = QueryHandler<Components...>;
+
+        class iterator {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = entity_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const entity_t*;
+            using reference = entity_t;
+
+            iterator(const std::vector<entity_t>* members, std::size_t pos) : _members(members), _pos(pos) {
+            }
+
+            entity_t operator*() const {
+                return (*_members)[_pos - 1];
+            }
+
+            iterator& operator++() {
+                _pos = std::min(_pos - 1, _members->size());
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator copy = *this;
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const iterator& other) const {
+                return _pos == other._pos;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return _pos != other._pos;
+            }
+
+          private:
+            const std::vector<entity_t>* _members;
+            std::size_t _pos;
+        };
+
+        Query(Registry& registry, Handler& handler) : _registry(registry), _handler(handler) {
+        }
+
+        /// @brief Iterate over members with callback (entity first, then the non-empty components)
+        template <typename Func> void each(Func&& func) {
+            _handler.record();
+            const std::vector<entity_t>& members = _handler.entities();
+            for (std::size_t pos = members.size(); pos > 0; pos = std::min(pos - 1, members.size())) {
+                invoke(func, members[pos - 1]);
+            }
+        }
+
+        /// @brief Iterates in chunks of at least minChunk members spread over the registry thread pool
+        /// @details Same contract as View::each_parallel: per-entity work only, structural changes (creations included)
+        /// through commands().
+        template <typename Func> void each_parallel(Func&& func, std::size_t minChunk = DefaultMinChunk) {
+            const std::vector<entity_t>& members = _handler.entities();
+            const std::size_t count = members.size();
+            const std::size_t chunks = _registry.chunkCount(count, minChunk);
+            if (chunks <= 1) {
+                each(func);
+                return;
+            }
+            _handler.record();
+            _registry.runChunks(chunks, [&](std::size_t chunk) {
+                const std::size_t first = count * chunk / chunks;
+                for (std::size_t pos = count * (chunk + 1) / chunks; pos > first; --pos) {
+                    invoke(func, members[pos - 1]);
+                }
+            });
+        }
+
+        /// @brief Checks if the entity matches the query
+        bool contains(entity_t entity) const {
+            return _handler.contains(entity);
+        }
+
+        /// @brief Get component for a member entity
+        template <typename T> T& get(entity_t entity) {
+            return _handler.template storage<T>().get(entity);
+        }
+
+        /// @brief Number of matching entities
+        std::size_t size() const {
+            return _handler.entities().size();
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /// @brief Begin iterator for range-based for loop, counts as one run
+        iterator begin() const {
+            _handler.record();
+            return iterator(&_handler.entities(), _handler.entities().size());
+        }
+
+        /// @brief End iterator for range-based for loop
+        iterator end() const {
+            return iterator(&_handler.entities(), 0);
+        }
+
+      private:
+        template <typename Func> void invoke(Func& func, entity_t entity) const {
+            std::apply(func, std::tuple_cat(std::tuple<entity_t>(entity),
+                                            componentArg(_handler.template storage<Components>(), entity)...));
+        }
+
+        Registry& _registry;
+        Handler& _handler;
+    };
+
+    /// @brief Gets or registers the persistent query over Components
+    /// @param name Label reported by queryStats(), the component names by default; only the first call sets it
+    template <typename... Components> Query<Components...> query(std::string name = {}) {
+        static_assert(sizeof...(Components) > 0, "A query must ask for at least one component type");
+        using Handler = QueryHandler<Components...>;
+
+        const std::size_t slot = querySlot<Handler>();
+        if (slot < _queryIndex.size() && _queryIndex[slot] != nullptr) {
+            return Query<Components...>(*this, static_cast<Handler&>(*_queryIndex[slot]));
+        }
+
+        if (name.empty()) {
+            ((name += (name.empty() ? "" : ", ") + SystemProfiler::nameOf<Components>()), ...);
+        }
+        auto handler = std::make_unique<Handler>(std::move(name), &getOrCreateStorage<Components>()...);
+        Handler& ref = *handler;
+        (listenersOf(rtype::ecs::ComponentFamily::id<Components>()).push_back(&ref), ...);
+        _queries.push_back(std::move(handler));
+        if (slot >= _queryIndex.size()) {
+            _queryIndex.resize(slot + 1, nullptr);
+        }
+        _queryIndex[slot] = &ref;
+
+        const std::vector<entity_t>* candidates = nullptr;
+        for (const auto* entities : {&getOrCreateStorage<Components>().entities()...}) {
+            if (candidates == nullptr || entities->size() < candidates->size()) {
+                candidates = entities;
+            }
+        }
+        for (entity_t entity : *candidates) {
+            ref.onConstruct(entity);
+        }
+        return Query<Components...>(*this, ref);
+    }
+
+    /// @brief Cost counters of every persistent query, in registration order
+    std::vector<QueryStats> queryStats() const;
+
+  private:
+    std::vector<std::uint32_t> _generations;
+    std::vector<std::uint8_t> _alive; ///< Per slot, 1 while the slot holds the entity of the current generation
+    std::vector<std::size_t> _freeIndices;
+    std::atomic<std::size_t> _slotCount{0};    ///< Slots handed out so far, _generations may lag behind reservations
+    std::atomic<std::size_t> _reservedFree{0}; ///< Free list entries reserved from its back, not popped yet
+
+    /// @brief Pops the free list entries taken by reserveEntity(), before anything else touches the free list
+    void settleReservations();
+    void growSlots(std::size_t index);
+    std::vector<std::unique_ptr<IComponentStorage>> _componentArrays;
+
+    struct IContextValue {
+        virtual ~IContextValue() = default;
+    };
+
+    template <typename T> struct ContextValue final : IContextValue {
+        template <typename... Args> explicit ContextValue(Args&&... args) : value(std::forward<Args>(args)...) {
+        }
+
+        T value;
+    };
+
+    /// @brief Context values indexed by component family id
+    std::vector<std::unique_ptr<IContextValue>> _context;
+    std::vector<std::unique_ptr<IGroupHandler>> _groups;
+    std::vector<std::unique_ptr<IQueryHandler>> _queries;
+    std::vector<IQueryHandler*> _queryIndex; ///< Queries by querySlot() of their handler type, for O(1) lookups
+
+    /// @brief Dense id per query handler type, shared by every registry like component family ids
+    template <typename Handler> static std::size_t querySlot() {
+        static const std::size_t value = _querySlots.fetch_add(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    static inline std::atomic<std::size_t> _querySlots{0};
+    std::vector<IGroupHandler*> _groupOwners;
+    std::vector<std::vector<IGroupHandler*>> _groupListeners;
+    std::unique_ptr<CommandBuffer> _commands;
+    std::uint32_t _changeTick = 0;
+
+    struct Slot {
+        Connection id;
+        ComponentListener listener;
+    };
+
+    struct Signals {
+        std::vector<Slot> construct;
+        std::vector<Slot> destroy;
+    };
+
+    std::vector<Signals> _signals;
+    Connection _nextConnection = 1;
+
+    Connection connect(std::size_t family, std::vector<Slot> Signals::*signal, ComponentListener listener);
+
+    void emit(std::size_t family, std::vector<Slot> Signals::*signal, entity_t entity) {
+        if (family < _signals.size()) {
+            const auto& slots = _signals[family].*signal;
+            for (std::size_t i = 0; i < slots.size(); ++i) {
+                slots[i].listener(*this, entity);
+            }
+        }
+    }
+
+    struct SnapshotType {
+        std::size_t family;
+        std::string name;
+        std::uint32_t size;
+        void (*save)(const Registry&, rtype::ecs::SnapshotWriter&);
+        void (*load)(Registry&, rtype::ecs::SnapshotReader&);
+    };
+
+    std::vector<SnapshotType> _snapshotTypes;
+
+    template <typename T> static void saveValue(rtype::ecs::SnapshotWriter& out, const T& value) {
+        if constexpr (rtype::ecs::SnapshotTraits<T>::custom) {
+            rtype::ecs::SnapshotTraits<T>::save(out, value);
+        } else {
+            out.write(value);
+        }
+    }
+
+    template <typename T> static T loadValue(rtype::ecs::SnapshotReader& in) {
+        if constexpr (rtype::ecs::SnapshotTraits<T>::custom) {
+            return rtype::ecs::SnapshotTraits<T>::load(in);
+        } else {
+            std::array<std::byte, sizeof(T)> raw;
+            std::memcpy(raw.data(), in.take(sizeof(T)), sizeof(T));
+            return std::bit_cast<T>(raw);
+        }
     }
 
-    /// @brief Helper to check if entity has all components
-    template <typename... Components> bool hasAllComponents(entity_t entity) const {
-        return (hasComponent<Components>(entity) && ...);
+    /// @brief Writes count, entities, the components as one block or through the type's hooks, then the context value
+    /// @details Empty components are restored from the entity list alone.
+    template <typename T> static void saveStorage(const Registry& registry, rtype::ecs::SnapshotWriter& out) {
+        const auto* storage = registry.findStorage<T>();
+        const std::uint64_t count = storage ? storage->size() : 0;
+        out.write(count);
+        if (count != 0) {
+            out.write(storage->entities().data(), count * sizeof(entity_t));
+            if constexpr (rtype::ecs::SnapshotTraits<T>::custom) {
+                for (std::size_t pos = 0; pos < count; ++pos) {
+                    saveValue(out, storage->data()[pos]);
+                }
+            } else if constexpr (!rtype::ecs::SparseSet<T>::membership_only) {
+                out.write(storage->data(), count * sizeof(T));
+            }
+        }
+        const T* context = registry.findContext<T>();
+        out.write(static_cast<std::uint8_t>(context != nullptr));
+        if (context) {
+            saveValue(out, *context);
+        }
+    }
+
+    template <typename T> static void loadStorage(Registry& registry, rtype::ecs::SnapshotReader& in) {
+        const auto count = static_cast<std::size_t>(in.read<std::uint64_t>());
+        const std::uint8_t* entities = in.take(count, sizeof(entity_t));
+        const std::uint8_t* components = nullptr;
+        if constexpr (!rtype::ecs::SnapshotTraits<T>::custom && !rtype::ecs::SparseSet<T>::membership_only) {
+            components = in.take(count, sizeof(T));
+        }
+        registry.reserve<T>(count);
+        for (std::size_t pos = 0; pos < count; ++pos) {
+            entity_t entity;
+            std::memcpy(&entity, entities + pos * sizeof(entity_t), sizeof(entity_t));
+            if (!registry.isValid(entity)) {
+                throw std::runtime_error("Snapshot holds a component of a destroyed entity");
+            }
+            if constexpr (rtype::ecs::SnapshotTraits<T>::custom) {
+                registry.addComponent<T>(entity, loadValue<T>(in));
+            } else if constexpr (rtype::ecs::SparseSet<T>::membership_only) {
+                registry.addComponent<T>(entity);
+            } else {
+                std::array<std::byte, sizeof(T)> raw;
+                std::memcpy(raw.data(), components + pos * sizeof(T), sizeof(T));
+                registry.addComponent<T>(entity, std::bit_cast<T>(raw));
+            }
+        }
+        if (in.read<std::uint8_t>() != 0) {
+            registry.emplaceContext<T>(loadValue<T>(in));
+        } else {
+            registry.eraseContext<T>();
+        }
+    }
+
+    std::vector<std::unique_ptr<CommandBuffer>> _chunkCommands;
+    std::atomic<bool> _chunksRunning{false};
+    std::unique_ptr<ThreadPool> _threadPool;
+    std::size_t _threadCount = 0;
+    std::mutex _threadPoolMutex;
+
+    /// @brief Number of chunks for a parallel loop over count entities, 1 when it is not worth splitting
+    std::size_t chunkCount(std::size_t count, std::size_t minChunk) const;
+
+    /// @brief Runs task(chunk) for every chunk on the thread pool with per-chunk command buffers
+    void runChunks(std::size_t chunks, const std::function<void(std::size_t)>& task);
+
+    std::vector<IGroupHandler*>& listenersOf(std::size_t family) {
+        if (family >= _groupListeners.size()) {
+            _groupListeners.resize(family + 1);
+            _groupOwners.resize(family + 1, nullptr);
+        }
+        return _groupListeners[family];
+    }
+
+    void notifyGroupsConstruct(std::size_t family, entity_t entity) {
+        if (family < _groupListeners.size()) {
+            for (auto* group : _groupListeners[family]) {
+                group->onConstruct(entity);
+            }
+        }
+    }
+
+    void notifyGroupsDestroy(std::size_t family, entity_t entity) {
+        if (family < _groupListeners.size()) {
+            for (auto* group : _groupListeners[family]) {
+                group->onDestroy(entity);
+            }
+        }
+    }
+
+    /// @brief The entity's component as a one-element tuple of reference, an empty tuple for empty components
+    template <typename T> static auto componentArg(rtype::ecs::SparseSet<T>& storage, entity_t entity) {
+        if constexpr (rtype::ecs::SparseSet<T>::membership_only) {
+            return std::tuple<>();
+        } else {
+            return std::tuple<T&>(storage.get(entity));
+        }
+    }
+
+    /// @brief Same as componentArg for the component at a packed slot
+    template <typename T> static auto componentArgAt(rtype::ecs::SparseSet<T>& storage, std::size_t pos) {
+        if constexpr (rtype::ecs::SparseSet<T>::membership_only) {
+            return std::tuple<>();
+        } else {
+            return std::tuple<T&>(storage.data()[pos]);
+        }
+    }
+
+    /// @brief Component storage for type T, nullptr if it was never created
+    template <typename T> const rtype::ecs::SparseSet<T>* findStorage() const {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _componentArrays.size() || !_componentArrays[family]) {
+            return nullptr;
+        }
+        return static_cast<const rtype::ecs::SparseSet<T>*>(_componentArrays[family].get());
+    }
+
+    /// @brief Gets or creates component storage for type T
+    template <typename T> rtype::ecs::SparseSet<T>& getOrCreateStorage() {
+        const std::size_t family = rtype::ecs::ComponentFamily::id<T>();
+        if (family >= _componentArrays.size()) {
+            _componentArrays.resize(family + 1);
+        }
+
+        auto& storage = _componentArrays[family];
+        if (!storage) {
+            storage = std::make_unique<rtype::ecs::SparseSet<T>>();
+        }
+
+        return static_cast<rtype::ecs::SparseSet<T>&>(*storage);
     }
 };
 
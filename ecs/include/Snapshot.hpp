@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace rtype::ecs {
+
+/// @brief Appends raw bytes to a snapshot blob
+/// @details Values are written in host byte order: a blob is meant to be restored by the same build on the same
+/// platform (checkpoints, rewind, offline benchmarks), not sent over the network.
+class SnapshotWriter {
+  public:
+    explicit SnapshotWriter(std::vector<std::uint8_t>& out) : _out(out) {
+    }
+
+    void write(const void* data, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        const std::size_t offset = _out.size();
+        _out.resize(offset + size);
+        std::memcpy(_out.data() + offset, data, size);
+    }
+
+    template <typename T> void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as bytes");
+        write(&value, sizeof(T));
+    }
+
+    void writeString(const std::string& value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        write(value.data(), value.size());
+    }
+
+    /// @brief Current end of the blob, used to patch a size written before its payload
+    std::size_t offset() const {
+        return _out.size();
+    }
+
+    template <typename T> void overwrite(std::size_t offset, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as bytes");
+        std::memcpy(_out.data() + offset, &value, sizeof(T));
+    }
+
+  private:
+    std::vector<std::uint8_t>& _out;
+};
+
+/// @brief Bounds-checked cursor over a snapshot blob
+/// @throws std::runtime_error from every read going past the end of the blob
+class SnapshotReader {
+  public:
+    SnapshotReader(const std::uint8_t* data, std::size_t size) : _data(data), _size(size) {
+    }
+
+    /// @brief Returns the next size bytes and moves past them
+    const std::uint8_t* take(std::size_t size) {
+        if (size > _size - _offset) {
+            throw std::runtime_error("Snapshot is truncated");
+        }
+        const std::uint8_t* bytes = _data + _offset;
+        _offset += size;
+        return bytes;
+    }
+
+    /// @brief Returns the next count elements of size bytes each and moves past them
+    const std::uint8_t* take(std::size_t count, std::size_t size) {
+        if (size != 0 && count > (_size - _offset) / size) {
+            throw std::runtime_error("Snapshot is truncated");
+        }
+        return take(count * size);
+    }
+
+    template <typename T> T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read as bytes");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string readString() {
+        const auto size = read<std::uint32_t>();
+        const auto* bytes = take(size);
+        return std::string(reinterpret_cast<const char*>(bytes), size);
+    }
+
+    bool atEnd() const {
+        return _offset == _size;
+    }
+
+  private:
+    const std::uint8_t* _data;
+    std::size_t _size;
+    std::size_t _offset = 0;
+};
+
+/// @brief Encoding of a component in registry snapshots
+/// @details Trivially copyable components are copied as raw bytes. Other components (strings, containers) need a
+/// specialization with custom = true and static save(SnapshotWriter&, const T&) / T load(SnapshotReader&) hooks.
+template <typename T> struct SnapshotTraits {
+    static constexpr bool custom = false;
+};
+
+} // namespace rtype::ecs
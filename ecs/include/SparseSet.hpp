@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "Entity.hpp"
+#include "interfaces/ecs/IComponentStorage.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Packed component storage: components live in a dense array, entities map to slots via a sparse index
+/// @details The sparse index is keyed by the entity slot index; the packed array keeps the full versioned handle so a
+/// stale handle never matches the component of the entity that recycled its slot. Each slot also carries the change
+/// tick at which its component was last written, stamped by the registry.
+/// Empty component types (markers such as UITag) only keep the entity arrays: membership is the whole information, so
+/// they cost no component bytes and get() hands out one shared instance.
+template <typename Component> class SparseSet final : public GameEngine::IComponentStorage {
+  public:
+    /// @brief True for empty component types, stored as membership only
+    static constexpr bool membership_only = std::is_empty_v<Component>;
+
+    using value_type = Component;
+    using entity_type = Entity;
+    using container_t = std::vector<Component>;
+    using size_type = typename container_t::size_type;
+    using iterator = typename container_t::iterator;
+    using const_iterator = typename container_t::const_iterator;
+
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    SparseSet() = default;
+    SparseSet(const SparseSet&) = default;
+    SparseSet(SparseSet&&) noexcept = default;
+    ~SparseSet() override = default;
+
+    SparseSet& operator=(const SparseSet&) = default;
+    SparseSet& operator=(SparseSet&&) noexcept = default;
+
+    bool contains(entity_type entity) const override {
+        const std::size_t idx = entity::index(entity);
+        return idx < _sparse.size() && _sparse[idx] != npos && _packed[_sparse[idx]] == entity;
+    }
+
+    /// @brief Unchecked access, the entity must be contained
+    Component& get(entity_type entity) {
+        if constexpr (membership_only) {
+            return _shared;
+        } else {
+            return _dense[_sparse[entity::index(entity)]];
+        }
+    }
+
+    const Component& get(entity_type entity) const {
+        if constexpr (membership_only) {
+            return _shared;
+        } else {
+            return _dense[_sparse[entity::index(entity)]];
+        }
+    }
+
+    Component* try_get(entity_type entity) {
+        return contains(entity) ? &get(entity) : nullptr;
+    }
+
+    const Component* try_get(entity_type entity) const {
+        return contains(entity) ? &get(entity) : nullptr;
+    }
+
+    Component& insert_at(entity_type entity, const Component& component) {
+        return emplace_at(entity, component);
+    }
+
+    Component& insert_at(entity_type entity, Component&& component) {
+        return emplace_at(entity, std::move(component));
+    }
+
+    /// @brief Constructs the component in place, replacing the current one if the entity already has it
+    template <class... Params> Component& emplace_at(entity_type entity, Params&&... params) {
+        const std::size_t idx = entity::index(entity);
+        if (contains(entity)) {
+            const size_type pos = _sparse[idx];
+            _versions[pos] = 0;
+            if constexpr (membership_only) {
+                ((void)params, ...);
+                return _shared;
+            } else {
+                _dense[pos] = Component(std::forward<Params>(params)...);
+                return _dense[pos];
+            }
+        }
+        if (idx >= _sparse.size()) {
+            _sparse.resize(idx + 1, npos);
+        }
+        _packed.push_back(entity);
+        _versions.push_back(0);
+        _sparse[idx] = _packed.size() - 1;
+        if constexpr (membership_only) {
+            ((void)params, ...);
+            return _shared;
+        } else {
+            _dense.emplace_back(std::forward<Params>(params)...);
+            return _dense.back();
+        }
+    }
+
+    /// @brief Removes the component in O(1) by moving the last packed element into the freed slot
+    void erase(entity_type entity) {
+        if (!contains(entity)) {
+            return;
+        }
+        const std::size_t idx = entity::index(entity);
+        size_type pos = _sparse[idx];
+        size_type last = _packed.size() - 1;
+        if (pos != last) {
+            if constexpr (!membership_only) {
+                _dense[pos] = std::move(_dense[last]);
+            }
+            _packed[pos] = _packed[last];
+            _versions[pos] = _versions[last];
+            _sparse[entity::index(_packed[pos])] = pos;
+        }
+        if constexpr (!membership_only) {
+            _dense.pop_back();
+        }
+        _packed.pop_back();
+        _versions.pop_back();
+        _sparse[idx] = npos;
+    }
+
+    /// @brief Swaps two packed slots, used by groups to keep their members at the front of the storage
+    void swap_at(size_type lhs, size_type rhs) {
+        if (lhs == rhs) {
+            return;
+        }
+        if constexpr (!membership_only) {
+            std::swap(_dense[lhs], _dense[rhs]);
+        }
+        std::swap(_packed[lhs], _packed[rhs]);
+        std::swap(_versions[lhs], _versions[rhs]);
+        _sparse[entity::index(_packed[lhs])] = lhs;
+        _sparse[entity::index(_packed[rhs])] = rhs;
+    }
+
+    void remove(entity_type entity) override {
+        erase(entity);
+    }
+
+    void clear() override {
+        _dense.clear();
+        _packed.clear();
+        _versions.clear();
+        _sparse.clear();
+    }
+
+    void reserve(size_type capacity) {
+        if constexpr (!membership_only) {
+            _dense.reserve(capacity);
+        }
+        _packed.reserve(capacity);
+        _versions.reserve(capacity);
+    }
+
+    size_type size() const override {
+        return _packed.size();
+    }
+
+    std::size_t memoryUsage() const override {
+        return sizeof(*this) + _dense.capacity() * sizeof(Component) + _packed.capacity() * sizeof(entity_type) +
+               _versions.capacity() * sizeof(std::uint32_t) + _sparse.capacity() * sizeof(size_type);
+    }
+
+    bool empty() const {
+        return _packed.empty();
+    }
+
+    /// @brief Slot of the entity in the packed arrays, npos if absent
+    size_type index_of(entity_type entity) const {
+        return contains(entity) ? _sparse[entity::index(entity)] : npos;
+    }
+
+    entity_type entity_at(size_type pos) const {
+        return _packed[pos];
+    }
+
+    /// @brief Entities in packed order, parallel to the component array of non-empty components
+    const std::vector<entity_type>& entities() const {
+        return _packed;
+    }
+
+    /// @brief Stamps the change tick of the entity's component, the entity must be contained
+    void touch(entity_type entity, std::uint32_t version) {
+        _versions[_sparse[entity::index(entity)]] = version;
+    }
+
+    /// @brief Change tick of the entity's component, the entity must be contained
+    std::uint32_t version(entity_type entity) const {
+        return _versions[_sparse[entity::index(entity)]];
+    }
+
+    /// @brief Change ticks in packed order, parallel to the component array
+    const std::vector<std::uint32_t>& versions() const {
+        return _versions;
+    }
+
+    /// @brief Component array in packed order, empty components have none and iterate as an empty range
+    Component* data() {
+        static_assert(!membership_only, "Empty components have no component array");
+        return _dense.data();
+    }
+
+    const Component* data() const {
+        static_assert(!membership_only, "Empty components have no component array");
+        return _dense.data();
+    }
+
+    iterator begin() {
+        return _dense.begin();
+    }
+    const_iterator begin() const {
+        return _dense.begin();
+    }
+    const_iterator cbegin() const {
+        return _dense.cbegin();
+    }
+
+    iterator end() {
+        return _dense.end();
+    }
+    const_iterator end() const {
+        return _dense.end();
+    }
+    const_iterator cend() const {
+        return _dense.cend();
+    }
+
+  private:
+    container_t _dense;
+    std::vector<entity_type> _packed;
+    std::vector<std::uint32_t> _versions;
+    std::vector<size_type> _sparse;
+    inline static Component _shared{};
+};
+
+} // namespace rtype::ecs
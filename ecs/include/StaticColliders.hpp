@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Registry.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Level obstacles in an immutable tile grid, built once when the level is loaded
+/// @details Boxes are kept in level coordinates. Each tile stores a range into one flat index array. The level scrolls
+/// as a whole, so follow() reads the current offset off a live obstacle instead of re-registering anything. Colliders
+/// are never added or removed after construction, and those whose entity was destroyed are skipped.
+class StaticColliders {
+  public:
+    struct Collider {
+        GameEngine::entity_t entity;
+        float x, y, width, height; ///< Box in level coordinates
+    };
+
+    /// @throws std::invalid_argument if a tile dimension is not positive
+    StaticColliders(std::vector<Collider> colliders, float tileWidth, float tileHeight);
+
+    /// @brief Reads the level offset off the first collider whose entity still has a Position
+    /// @return false once every collider is gone
+    bool follow(GameEngine::Registry& registry);
+
+    /// @brief Sorted indices of the colliders that may overlap a box in world coordinates
+    /// @details The query is widened by one tile per side, which absorbs the rounding drift between obstacles that
+    /// MovementSystem moves one by one. Callers test the actual boxes.
+    void query(float x, float y, float width, float height, std::vector<std::uint32_t>& out) const;
+
+    const Collider& collider(std::size_t index) const {
+        return _colliders[index];
+    }
+
+    std::size_t size() const {
+        return _colliders.size();
+    }
+
+  private:
+    /// @brief Tiles overlapped by [min, max], false if the span misses the level
+    bool tileSpan(float min, float max, float origin, float tile, int count, int& first, int& last) const;
+
+    std::vector<Collider> _colliders;
+    float _tileWidth;
+    float _tileHeight;
+    float _minX = 0.0f;
+    float _minY = 0.0f;
+    int _columns = 0;
+    int _rows = 0;
+    std::vector<std::uint32_t> _tileStart; ///< Tile t owns _tileItems[_tileStart[t], _tileStart[t + 1])
+    std::vector<std::uint32_t> _tileItems;
+    std::size_t _firstLive = 0;
+    float _offsetX = 0.0f;
+    float _offsetY = 0.0f;
+};
+
+} // namespace rtype::ecs
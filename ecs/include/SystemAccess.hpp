@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "ComponentFamily.hpp"
+#include "Registry.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Components a system reads and writes, used by the SystemManager to schedule systems side by side
+/// @details A system that declares nothing is exclusive and never shares a stage. Declared systems may only touch
+/// their declared components and must route structural changes (add, remove, destroy) through registry.commands();
+/// creating entities or mutating the registry directly requires exclusive().
+class SystemAccess {
+  public:
+    /// @brief Declares read-only access to the given components
+    template <typename... Components> SystemAccess& reads() {
+        (track<Components>(_reads), ...);
+        _declared = true;
+        return *this;
+    }
+
+    /// @brief Declares write access (values, or add/remove through the command buffer) to the given components
+    template <typename... Components> SystemAccess& writes() {
+        (track<Components>(_writes), ...);
+        _declared = true;
+        return *this;
+    }
+
+    /// @brief Runs the system alone, for systems creating entities or changing the registry directly
+    SystemAccess& exclusive() {
+        _exclusive = true;
+        _declared = true;
+        return *this;
+    }
+
+    bool isExclusive() const {
+        return _exclusive || !_declared;
+    }
+
+    /// @brief True when both systems cannot run in the same stage
+    bool conflictsWith(const SystemAccess& other) const {
+        if (isExclusive() || other.isExclusive()) {
+            return true;
+        }
+        return intersects(_writes, other._writes) || intersects(_writes, other._reads) ||
+               intersects(_reads, other._writes);
+    }
+
+    /// @brief Creates the storages of every declared component so concurrent systems never allocate one
+    void prepare(GameEngine::Registry& registry) const {
+        for (auto assure : _assures) {
+            assure(registry);
+        }
+    }
+
+  private:
+    using AssureFn = void (*)(GameEngine::Registry&);
+
+    template <typename T> void track(std::vector<std::size_t>& families) {
+        const std::size_t family = ComponentFamily::id<T>();
+        if (std::find(families.begin(), families.end(), family) == families.end()) {
+            families.push_back(family);
+            _assures.push_back([](GameEngine::Registry& registry) { registry.reserve<T>(0); });
+        }
+    }
+
+    static bool intersects(const std::vector<std::size_t>& lhs, const std::vector<std::size_t>& rhs) {
+        for (std::size_t family : lhs) {
+            if (std::find(rhs.begin(), rhs.end(), family) != rhs.end()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::size_t> _reads;
+    std::vector<std::size_t> _writes;
+    std::vector<AssureFn> _assures;
+    bool _declared = false;
+    bool _exclusive = false;
+};
+
+} // namespace rtype::ecs
@@ -3,13 +3,20 @@
 #include <vector>
 #include <memory>
 #include "interfaces/ecs/ISystem.hpp"
+#include "CommandBuffer.hpp"
+#include "SystemAccess.hpp"
+#include "SystemProfiler.hpp"
 
 namespace GameEngine {
 
-class Registry;
-
 class SystemManager {
   public:
+    /// @brief How update() runs the registered systems
+    enum class ExecutionMode {
+        Serial,  ///< One system after the other in registration order, for debugging
+        Parallel ///< Non-conflicting systems of a stage run concurrently on the registry thread pool
+    };
+
     SystemManager() = default;
     ~SystemManager() = default;
 
@@ -20,17 +27,57 @@ class SystemManager {
      */
     template <typename T, typename... Args> void addSystem(Args&&... args) {
         _systems.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+        _accesses.emplace_back();
+        _systems.back()->declareAccess(_accesses.back());
+        if constexpr (SystemProfiler::Enabled) {
+            _profiler.addSystem(SystemProfiler::nameOf<T>());
+        }
+        _stagesDirty = true;
+        _preparedFor = nullptr;
     }
 
     /**
      * @brief Updates all registered systems.
+     * @details In serial mode pending registry commands are flushed before the first system and after each one. In
+     * parallel mode systems are grouped into stages from their declared accesses: a system joins the stage right after
+     * the last stage holding a conflicting system registered before it. Each system of a stage records into its own
+     * command buffer, and the buffers are flushed in registration order once the stage is done, so the outcome does
+     * not depend on thread timing. The first update on a registry runs serially so that lazily created storages and
+     * groups exist before systems share a stage.
      * @param registry The entity registry.
      * @param dt The delta time.
      */
-    void update(Registry& registry, double dt) {
-        for (auto& system : _systems) {
-            system->update(registry, dt);
+    void update(Registry& registry, double dt);
+
+    /**
+     * @brief Selects serial or parallel execution.
+     * @param mode The execution mode.
+     */
+    void setExecutionMode(ExecutionMode mode) {
+        _mode = mode;
+    }
+
+    /**
+     * @brief Returns the current execution mode.
+     */
+    ExecutionMode executionMode() const {
+        return _mode;
+    }
+
+    /**
+     * @brief Returns the parallel stages as indices into the registration order.
+     */
+    const std::vector<std::vector<std::size_t>>& stages();
+
+    /**
+     * @brief Returns the tick time percentiles of every system, in registration order.
+     * @details Empty when the build does not define RTYPE_PROFILE_SYSTEMS. Not synchronized with update().
+     */
+    std::vector<SystemStats> timings() const {
+        if constexpr (SystemProfiler::Enabled) {
+            return _profiler.stats();
         }
+        return {};
     }
 
     /**
@@ -38,10 +85,27 @@ class SystemManager {
      */
     void clear() {
         _systems.clear();
+        _profiler.clear();
+        _accesses.clear();
+        _stages.clear();
+        _stageCommands.clear();
+        _stagesDirty = false;
+        _preparedFor = nullptr;
     }
 
   private:
+    void updateSerial(Registry& registry, double dt);
+    void runSystem(std::size_t index, Registry& registry, double dt);
+    void runStage(Registry& registry, const std::vector<std::size_t>& stage, double dt);
+
     std::vector<std::unique_ptr<rtype::ecs::ISystem>> _systems;
+    std::vector<rtype::ecs::SystemAccess> _accesses;
+    std::vector<std::vector<std::size_t>> _stages;
+    std::vector<std::unique_ptr<CommandBuffer>> _stageCommands;
+    SystemProfiler _profiler;
+    ExecutionMode _mode = ExecutionMode::Serial;
+    bool _stagesDirty = false;
+    Registry* _preparedFor = nullptr;
 };
 
 } // namespace GameEngine
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace GameEngine {
+
+/// @brief Tick time percentiles of one system over the recorded window, in milliseconds
+struct SystemStats {
+    std::string name;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    std::size_t entities = 0; ///< Entities walked by views and groups during the last tick
+    std::size_t samples = 0;
+};
+
+/// @brief Per-system ring buffers of tick durations and walked entity counts
+/// @details Only compiled in when RTYPE_PROFILE_SYSTEMS is defined, callers guard every use with
+/// `if constexpr (SystemProfiler::Enabled)` so a disabled build keeps no clock reads nor counters.
+class SystemProfiler {
+  public:
+#if defined(RTYPE_PROFILE_SYSTEMS)
+    static constexpr bool Enabled = true;
+#else
+    static constexpr bool Enabled = false;
+#endif
+    /// @brief Samples kept per system, 4 seconds of ticks at 60 Hz
+    static constexpr std::size_t Capacity = 240;
+
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Adds a track, in registration order
+    void addSystem(std::string name);
+
+    /// @brief Drops every track
+    void clear();
+
+    /// @brief Starts timing a system on the calling thread
+    static Clock::time_point begin() {
+        _visited = 0;
+        return Clock::now();
+    }
+
+    /// @brief Stores the duration since start and the entities walked on this thread since begin()
+    void end(std::size_t system, Clock::time_point start);
+
+    /// @brief Percentiles of every track, in registration order
+    std::vector<SystemStats> stats() const;
+
+    /// @brief Credits entities walked by the calling thread to the system being timed
+    static void addVisited(std::size_t count) {
+        _visited += count;
+    }
+
+    /// @brief Readable unqualified name of a system type, e.g. "MovementSystem"
+    template <typename T> static std::string nameOf() {
+        return readableName(typeid(T).name());
+    }
+
+  private:
+    struct Sample {
+        float micros;
+        std::uint32_t entities;
+    };
+
+    struct Track {
+        std::string name;
+        std::array<Sample, Capacity> samples{};
+        std::size_t next = 0;
+        std::size_t count = 0;
+    };
+
+    static std::string readableName(const char* typeName);
+
+    std::vector<Track> _tracks;
+    static inline thread_local std::size_t _visited = 0;
+};
+
+} // namespace GameEngine
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "net/MessageData.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Interned tag name, compared as an integer
+using TagId = std::uint16_t;
+
+namespace tags {
+
+/// @brief Tags known to server and client alike: a known tag's id is its index, so entries may only be appended
+inline constexpr std::array<std::string_view, 35> Known = {
+    "",
+    "Player",
+    "Obstacle",
+    "Obstacle_Floor",
+    "Obstacle_Train_3",
+    "Obstacle_Train_4",
+    "ForcePodItem",
+    "ForcePod",
+    "Monster_0_Top",
+    "Monster_0_Bot",
+    "Monster_0_Left",
+    "Monster_0_Right",
+    "Monster_Wave_2_Left",
+    "Monster_Wave_2_Right",
+    "Boss_1",
+    "Boss_2",
+    "Monster_0_Ball",
+    "shot",
+    "shot_death-charge1",
+    "shot_death-charge2",
+    "shot_death-charge3",
+    "shot_death-charge4",
+    "Boss_1_Bayblade",
+    "Boss_1_Attack",
+    "Boss_2_Projectile",
+    "Boss_2_Projectile_2",
+    "PodProjectile",
+    "PodProjectileRed",
+    "Laser",
+    "BasicProjectile",
+    "Platform",
+    "Hole",
+    "Monster",
+    "EnemyMonster",
+    "PlayerProjectile",
+};
+
+/// @brief Id of a known tag, unknown names fail to compile
+consteval TagId known(std::string_view name) {
+    for (std::size_t id = 0; id < Known.size(); ++id) {
+        if (Known[id] == name) {
+            return static_cast<TagId>(id);
+        }
+    }
+    throw "Tag is not listed in tags::Known";
+}
+
+inline constexpr TagId None = known("");
+inline constexpr TagId Player = known("Player");
+inline constexpr TagId Obstacle = known("Obstacle");
+inline constexpr TagId ObstacleFloor = known("Obstacle_Floor");
+inline constexpr TagId ObstacleTrain3 = known("Obstacle_Train_3");
+inline constexpr TagId ObstacleTrain4 = known("Obstacle_Train_4");
+inline constexpr TagId ForcePodItem = known("ForcePodItem");
+inline constexpr TagId ForcePod = known("ForcePod");
+inline constexpr TagId Monster0Top = known("Monster_0_Top");
+inline constexpr TagId Monster0Bot = known("Monster_0_Bot");
+inline constexpr TagId Monster0Left = known("Monster_0_Left");
+inline constexpr TagId Monster0Right = known("Monster_0_Right");
+inline constexpr TagId MonsterWave2Left = known("Monster_Wave_2_Left");
+inline constexpr TagId MonsterWave2Right = known("Monster_Wave_2_Right");
+inline constexpr TagId Boss1 = known("Boss_1");
+inline constexpr TagId Boss2 = known("Boss_2");
+inline constexpr TagId Monster0Ball = known("Monster_0_Ball");
+inline constexpr TagId Shot = known("shot");
+inline constexpr TagId ShotDeathCharge1 = known("shot_death-charge1");
+inline constexpr TagId ShotDeathCharge2 = known("shot_death-charge2");
+inline constexpr TagId ShotDeathCharge3 = known("shot_death-charge3");
+inline constexpr TagId ShotDeathCharge4 = known("shot_death-charge4");
+inline constexpr TagId Boss1Bayblade = known("Boss_1_Bayblade");
+inline constexpr TagId Boss1Attack = known("Boss_1_Attack");
+inline constexpr TagId Boss2Projectile = known("Boss_2_Projectile");
+inline constexpr TagId Boss2Projectile2 = known("Boss_2_Projectile_2");
+inline constexpr TagId PodProjectile = known("PodProjectile");
+inline constexpr TagId PodProjectileRed = known("PodProjectileRed");
+inline constexpr TagId Laser = known("Laser");
+inline constexpr TagId BasicProjectile = known("BasicProjectile");
+inline constexpr TagId Platform = known("Platform");
+inline constexpr TagId Hole = known("Hole");
+inline constexpr TagId Monster = known("Monster");
+inline constexpr TagId EnemyMonster = known("EnemyMonster");
+inline constexpr TagId PlayerProjectile = known("PlayerProjectile");
+
+/// @brief Charged player shots, from "shot_death-charge1" to "shot_death-charge4"
+constexpr bool isChargeShot(TagId id) {
+    return id >= ShotDeathCharge1 && id <= ShotDeathCharge4;
+}
+
+/// @brief Player shots, plain or charged
+constexpr bool isPlayerShot(TagId id) {
+    return id == Shot || isChargeShot(id);
+}
+
+/// @brief Network entity type and sub type announced in EntitySpawn for a tag
+struct SpawnType {
+    TagId tag;
+    std::uint16_t entityType;
+    std::uint16_t subType;
+};
+
+/// @brief Tags the client draws with a dedicated sprite, untagged or unlisted entities use sub type 0
+inline constexpr std::array<SpawnType, 26> SpawnTypes = {{
+    {Obstacle, net::EntityType::OBSTACLE, 0},
+    {ObstacleFloor, net::EntityType::OBSTACLE, 1},
+    {ObstacleTrain3, net::EntityType::OBSTACLE, 2},
+    {ObstacleTrain4, net::EntityType::OBSTACLE, 3},
+    {ForcePodItem, net::EntityType::POWERUP, 1},
+    {ForcePod, net::EntityType::POWERUP, 2},
+    {Monster0Top, net::EntityType::ENEMY, 1},
+    {Monster0Bot, net::EntityType::ENEMY, 2},
+    {Monster0Left, net::EntityType::ENEMY, 3},
+    {Monster0Right, net::EntityType::ENEMY, 4},
+    {MonsterWave2Left, net::EntityType::ENEMY, 5},
+    {MonsterWave2Right, net::EntityType::ENEMY, 6},
+    {Boss1, net::EntityType::ENEMY, 100},
+    {Boss2, net::EntityType::ENEMY, 101},
+    {Monster0Ball, net::EntityType::PROJECTILE, 1},
+    {ShotDeathCharge1, net::EntityType::PROJECTILE, 10},
+    {ShotDeathCharge2, net::EntityType::PROJECTILE, 11},
+    {ShotDeathCharge3, net::EntityType::PROJECTILE, 12},
+    {ShotDeathCharge4, net::EntityType::PROJECTILE, 13},
+    {Boss1Bayblade, net::EntityType::PROJECTILE, 20},
+    {Boss1Attack, net::EntityType::PROJECTILE, 21},
+    {Boss2Projectile, net::EntityType::PROJECTILE, 22},
+    {Boss2Projectile2, net::EntityType::PROJECTILE, 23},
+    {PodProjectile, net::EntityType::PROJECTILE, 30},
+    {PodProjectileRed, net::EntityType::PROJECTILE, 31},
+    {Laser, net::EntityType::PROJECTILE, 40},
+}};
+
+namespace detail {
+
+consteval std::array<std::int16_t, Known.size()> spawnTypeIndex() {
+    std::array<std::int16_t, Known.size()> index{};
+    index.fill(-1);
+    for (std::size_t i = 0; i < SpawnTypes.size(); ++i) {
+        index[SpawnTypes[i].tag] = static_cast<std::int16_t>(i);
+    }
+    return index;
+}
+
+inline constexpr std::array<std::int16_t, Known.size()> SpawnTypeIndex = spawnTypeIndex();
+
+} // namespace detail
+
+/// @brief Network type of a tagged entity, in O(1)
+/// @details Entities with a Projectile component are always sent as projectiles and others never are, except the
+/// Laser which is a projectile either way.
+constexpr SpawnType spawnTypeOf(TagId tag, bool isProjectile) {
+    if (tag < Known.size() && detail::SpawnTypeIndex[tag] >= 0) {
+        const SpawnType& type = SpawnTypes[static_cast<std::size_t>(detail::SpawnTypeIndex[tag])];
+        if ((type.entityType == net::EntityType::PROJECTILE) == isProjectile || tag == Laser) {
+            return type;
+        }
+    }
+    return {tag, isProjectile ? net::EntityType::PROJECTILE : net::EntityType::ENEMY, 0};
+}
+
+/// @brief Tag announced by an EntitySpawn, None if the pair is not listed
+constexpr TagId tagOfSpawn(std::uint16_t entityType, std::uint16_t subType) {
+    for (const SpawnType& type : SpawnTypes) {
+        if (type.entityType == entityType && type.subType == subType) {
+            return type.tag;
+        }
+    }
+    return None;
+}
+
+} // namespace tags
+
+/// @brief Process-wide interning of tag names
+/// @details Known tags keep their fixed ids; other names get the next free id on first use, so only known ids may be
+/// exchanged between processes. Interning and name lookups are thread-safe, comparisons never need them.
+class TagTable {
+  public:
+    /// @brief Id of the name, registering it if needed
+    static TagId intern(std::string_view name);
+
+    /// @brief Id of the name if it was already interned
+    static std::optional<TagId> find(std::string_view name);
+
+    /// @brief Name of an interned id, empty for unknown ids
+    static const std::string& name(TagId id);
+};
+
+} // namespace rtype::ecs
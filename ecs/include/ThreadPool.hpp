@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GameEngine {
+
+/// @brief Fixed set of worker threads running indexed batches, the calling thread takes part in each batch
+class ThreadPool {
+  public:
+    /// @brief Starts the given number of workers, zero runs every batch on the calling thread
+    explicit ThreadPool(std::size_t workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t workerCount() const {
+        return _workers.size();
+    }
+
+    /// @brief Calls task(i) for every i in [0, count) and returns once all calls are done, task must not throw
+    /// @details When another batch is already running, e.g. a nested call from inside a task, the calls are made
+    /// on the calling thread instead.
+    void run(std::size_t count, const std::function<void(std::size_t)>& task);
+
+  private:
+    void workerLoop();
+    void drain();
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    const std::function<void(std::size_t)>* _task = nullptr;
+    std::size_t _count = 0;
+    std::atomic<std::size_t> _next{0};
+    std::size_t _busy = 0;
+    std::uint64_t _generation = 0;
+    bool _stop = false;
+    std::atomic<bool> _running{false};
+};
+
+} // namespace GameEngine
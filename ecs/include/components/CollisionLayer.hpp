@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace rtype::ecs::component {
@@ -15,6 +17,45 @@ enum class CollisionLayer : uint8_t {
     Companion = 7
 };
 
+inline constexpr std::size_t CollisionLayerCount = 8;
+
+/// @brief Bit l of row k is set when contact between layers k and l has an effect; rows are symmetric
+using CollisionMatrix = std::array<std::uint8_t, CollisionLayerCount>;
+
+namespace detail {
+
+consteval CollisionMatrix collisionMatrix(bool friendlyFire) {
+    using CL = CollisionLayer;
+    CollisionMatrix matrix{};
+    auto allow = [&matrix](CL a, CL b) {
+        matrix[static_cast<std::size_t>(a)] |= static_cast<std::uint8_t>(1u << static_cast<unsigned>(b));
+        matrix[static_cast<std::size_t>(b)] |= static_cast<std::uint8_t>(1u << static_cast<unsigned>(a));
+    };
+    allow(CL::Player, CL::Enemy);
+    allow(CL::Player, CL::EnemyProjectile);
+    allow(CL::Enemy, CL::PlayerProjectile);
+    allow(CL::Player, CL::PowerUp);
+    allow(CL::Player, CL::Obstacle);
+    allow(CL::PlayerProjectile, CL::Obstacle);
+    allow(CL::PlayerProjectile, CL::EnemyProjectile);
+    if (friendlyFire) {
+        allow(CL::Player, CL::Player);
+        allow(CL::Player, CL::PlayerProjectile);
+    }
+    return matrix;
+}
+
+} // namespace detail
+
+inline constexpr CollisionMatrix DefaultCollisionMatrix = detail::collisionMatrix(false);
+inline constexpr CollisionMatrix FriendlyFireCollisionMatrix = detail::collisionMatrix(true);
+
+/// @brief Whether two layers react to each other, a table lookup
+constexpr bool layersInteract(CollisionLayer layer1, CollisionLayer layer2, bool friendlyFire = false) {
+    const CollisionMatrix& matrix = friendlyFire ? FriendlyFireCollisionMatrix : DefaultCollisionMatrix;
+    return (matrix[static_cast<std::size_t>(layer1)] >> static_cast<unsigned>(layer2)) & 1u;
+}
+
 struct Collidable {
     CollisionLayer layer;
     bool is_active;
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <cstdint>
-#include <unordered_map>
-#include <vector>
+#include <type_traits>
+#include "../Assets.hpp"
 
 namespace rtype::ecs::component {
 
 /// @brief Sprite and animation rendering component
+/// @details Textures are interned and animation frames live in the shared AnimationClips library, so the component
+/// stays trivially copyable and allocation free.
 struct Drawable {
-    std::string texture_name;
+    TextureId texture;
     uint32_t sprite_index;
     uint32_t animation_frame;
     uint32_t current_sprite;
@@ -22,31 +25,40 @@ struct Drawable {
     float animation_timer;
     int frame_count;
     float animation_speed;
-    std::unordered_map<std::string, std::vector<uint32_t>> animation_sequences;
-    std::string current_state = "";
-    std::string last_state = "";
+    ClipId clip = clips::None;      ///< Clip being played, None for plain frame_count animation
+    ClipId last_clip = clips::None; ///< Clip played last frame, a difference restarts the clip
     uint32_t animation_index = 0;
     bool loop;
     float rotation = 0.0f;
 
     Drawable()
-        : texture_name(""), sprite_index(0), animation_frame(0), current_sprite(0), scale_x(1.0f), scale_y(1.0f),
-          rect_x(0), rect_y(0), rect_width(0), rect_height(0), animation_timer(0.0f), frame_count(1),
-          animation_speed(0.1f), loop(true) {
+        : texture(0), sprite_index(0), animation_frame(0), current_sprite(0), scale_x(1.0f), scale_y(1.0f), rect_x(0),
+          rect_y(0), rect_width(0), rect_height(0), animation_timer(0.0f), frame_count(1), animation_speed(0.1f),
+          loop(true) {
     }
 
-    Drawable(const std::string& name, uint32_t index, uint32_t frame = 0, float sx = 1.0f, float sy = 1.0f)
-        : texture_name(name), sprite_index(index), animation_frame(frame), current_sprite(frame), scale_x(sx),
-          scale_y(sy), rect_x(0), rect_y(0), rect_width(0), rect_height(0), animation_timer(0.0f), frame_count(1),
-          animation_speed(0.1f), loop(true) {
+    Drawable(std::string_view name, uint32_t index, uint32_t frame = 0, float sx = 1.0f, float sy = 1.0f)
+        : texture(TextureTable::intern(name)), sprite_index(index), animation_frame(frame), current_sprite(frame),
+          scale_x(sx), scale_y(sy), rect_x(0), rect_y(0), rect_width(0), rect_height(0), animation_timer(0.0f),
+          frame_count(1), animation_speed(0.1f), loop(true) {
     }
 
-    Drawable(const std::string& name, int rx, int ry, int rw, int rh, float sx = 1.0f, float sy = 1.0f, int frames = 1,
+    Drawable(std::string_view name, int rx, int ry, int rw, int rh, float sx = 1.0f, float sy = 1.0f, int frames = 1,
              float speed = 0.1f, bool loop_anim = true, uint32_t index = 0, uint32_t frame = 0)
-        : texture_name(name), sprite_index(index), animation_frame(frame), current_sprite(frame), scale_x(sx),
-          scale_y(sy), rect_x(rx), rect_y(ry), rect_width(rw), rect_height(rh), animation_timer(0.0f),
+        : texture(TextureTable::intern(name)), sprite_index(index), animation_frame(frame), current_sprite(frame),
+          scale_x(sx), scale_y(sy), rect_x(rx), rect_y(ry), rect_width(rw), rect_height(rh), animation_timer(0.0f),
           frame_count(frames), animation_speed(speed), loop(loop_anim) {
     }
+
+    const std::string& texture_name() const {
+        return TextureTable::name(texture);
+    }
+
+    void set_texture(std::string_view name) {
+        texture = TextureTable::intern(name);
+    }
 };
 
+static_assert(std::is_trivially_copyable_v<Drawable>);
+
 } // namespace rtype::ecs::component
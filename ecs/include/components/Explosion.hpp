@@ -2,9 +2,7 @@
 
 namespace rtype::ecs::component {
 
-struct Explosion {
-    int dummy = 0;
-    Explosion() = default;
-};
+/// @brief Marker component for explosion effects, stored as membership only
+struct Explosion {};
 
 } // namespace rtype::ecs::component
@@ -2,8 +2,7 @@
 
 namespace rtype::ecs::component {
 
-struct ScreenMode {
-    bool active = true;
-};
+/// @brief Marker component for entities held on screen, stored as membership only
+struct ScreenMode {};
 
 } // namespace rtype::ecs::component
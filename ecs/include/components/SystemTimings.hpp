@@ -0,0 +1,14 @@
+#pragma once
+
+namespace rtype::ecs::component {
+
+/// @brief Dev tools overlay text listing the most expensive systems of the local SystemManager
+struct SystemTimings {
+    float refreshTimer;
+    unsigned int maxLines;
+
+    SystemTimings() : refreshTimer(0.0f), maxLines(5) {
+    }
+};
+
+} // namespace rtype::ecs::component
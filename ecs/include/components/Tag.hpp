@@ -1,14 +1,25 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include "../Tags.hpp"
 
 namespace rtype::ecs::component {
 
-/// @brief Named tag for entity categorization
+/// @brief Named tag for entity categorization, stored as an interned id
 struct Tag {
-    std::string name;
+    TagId id = tags::None;
 
-    Tag(const std::string& n = "") : name(n) {
+    Tag() = default;
+
+    Tag(TagId tag) : id(tag) {
+    }
+
+    Tag(std::string_view name) : id(TagTable::intern(name)) {
+    }
+
+    const std::string& name() const {
+        return TagTable::name(id);
     }
 };
 
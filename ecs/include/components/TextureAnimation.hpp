@@ -2,18 +2,23 @@
 
 #include <vector>
 #include <string>
+#include "../Assets.hpp"
 
 namespace rtype::ecs::component {
 
 struct TextureAnimation {
-    std::vector<std::string> frameTextureNames;
+    std::vector<TextureId> frameTextures;
     float frameTime;
     float elapsedTime;
     int currentFrameIndex;
     bool loop;
 
     TextureAnimation(const std::vector<std::string>& frames, float time, bool loopAnim = true)
-        : frameTextureNames(frames), frameTime(time), elapsedTime(0.0f), currentFrameIndex(0), loop(loopAnim) {
+        : frameTime(time), elapsedTime(0.0f), currentFrameIndex(0), loop(loopAnim) {
+        frameTextures.reserve(frames.size());
+        for (const auto& frame : frames) {
+            frameTextures.push_back(TextureTable::intern(frame));
+        }
     }
 
     TextureAnimation() : frameTime(0.1f), elapsedTime(0.0f), currentFrameIndex(0), loop(true) {
@@ -1,6 +1,6 @@
 #pragma once
-#include <string>
 #include "MovementPattern.hpp"
+#include "../Tags.hpp"
 
 namespace rtype::ecs::component {
 
@@ -16,7 +16,7 @@ struct Weapon {
     float directionY = 0.0f;
     float spawnOffsetX = 20.0f;
     float spawnOffsetY = 0.0f;
-    std::string projectileTag = "BasicProjectile";
+    TagId projectileTag = tags::BasicProjectile;
     int chargeLevel = 0;
     MovementPatternType projectilePattern = MovementPatternType::None;
     float projectileAmplitude = 0.0f;
@@ -1,17 +1,60 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include "interfaces/ecs/ISystem.hpp"
+#include "../AabbKernel.hpp"
+#include "../CollisionGrid.hpp"
 #include "../Registry.hpp"
+#include "../StaticColliders.hpp"
 #include "../components/CollisionLayer.hpp"
 
 namespace rtype::ecs {
 
 class CollisionSystem : public ISystem {
   public:
+    /// @brief How candidate pairs are found, every mode yields the same collisions in the same order
+    enum class Broadphase {
+        BruteForce,   ///< Every pair of collidables
+        LayerBuckets, ///< Every pair of interacting layers, from per-layer buckets
+        Grid,         ///< Pairs of interacting layers sharing a cell of a uniform grid over the map
+        SweepAndPrune ///< Pairs of interacting layers whose x extents overlap, from a persistent sorted endpoint list
+    };
+
+    /// @brief Side of a grid cell, the 1920x1080 map splits into 16x9 cells
+    static constexpr float GridCellSize = 120.0f;
+
+    explicit CollisionSystem(Broadphase mode = Broadphase::Grid);
     ~CollisionSystem() override = default;
     void update(GameEngine::Registry& registry, double dt) override;
 
+    void setBroadphase(Broadphase mode) {
+        broadphase_ = mode;
+    }
+
+    Broadphase broadphase() const {
+        return broadphase_;
+    }
+
   private:
+    /// @brief Per-tick snapshot of a collidable, as registered in the broadphase
+    struct Entry {
+        float x, y, width, height;
+        component::CollisionLayer layer;
+
+        bool operator==(const Entry& other) const = default;
+    };
+
+    /// @brief Start or end of a collidable's x extent, kept sorted from one tick to the next
+    struct Endpoint {
+        float value;
+        bool isMax;
+        std::uint32_t slot; ///< Index in entities_, refreshed every tick
+        GameEngine::entity_t entity;
+    };
+
     static bool CheckAABBCollision(float x1, float y1, float w1, float h1, float x2, float y2, float w2, float h2);
 
     static bool ShouldCollide(component::CollisionLayer layer1, component::CollisionLayer layer2,
@@ -19,6 +62,52 @@ class CollisionSystem : public ISystem {
 
     void HandleCollision(GameEngine::Registry& registry, GameEngine::entity_t entity1, GameEngine::entity_t entity2,
                          component::CollisionLayer layer1, component::CollisionLayer layer2);
+
+    /// @brief Narrow phase of one candidate pair, true if the pair collided and was handled
+    bool TestPair(GameEngine::Registry& registry, GameEngine::entity_t entity1, GameEngine::entity_t entity2,
+                  bool friendly_fire_enabled);
+
+    /// @brief Tests the collidables against the level's StaticColliders, before any pair of collidables
+    void RunStatic(GameEngine::Registry& registry, StaticColliders& statics, bool friendly_fire_enabled);
+
+    void RunBruteForce(GameEngine::Registry& registry, bool friendly_fire_enabled);
+    void RunIndexed(GameEngine::Registry& registry, bool friendly_fire_enabled);
+
+    /// @brief Adds the entry at index to the grid cells or the layer bucket
+    void Register(std::uint32_t index);
+
+    /// @brief Sorted indices after `after` that may interact with the entry at index
+    void GatherCandidates(std::size_t index, std::size_t after, const component::CollisionMatrix& matrix);
+
+    /// @brief Drops the candidates whose box misses the entry at index, with the packed overlap kernel
+    void NarrowCandidates(std::size_t index);
+
+    /// @brief Brings the endpoints up to date with the entries, insertion-sorts them and collects overlapping pairs
+    void Sweep(GameEngine::Registry& registry, const component::CollisionMatrix& matrix);
+
+    /// @brief Re-registers the entry at index if it changed since registration, true if it did
+    bool RefreshEntry(GameEngine::Registry& registry, std::size_t index);
+
+    Entry CurrentEntry(GameEngine::Registry& registry, GameEngine::entity_t entity) const;
+
+    Broadphase broadphase_;
+    CollisionGrid grid_;
+    std::array<std::vector<std::uint32_t>, component::CollisionLayerCount> buckets_;
+    std::vector<GameEngine::entity_t> entities_;
+    std::vector<Entry> entries_;
+    std::vector<std::uint32_t> candidates_;
+    AabbBlock candidateBoxes_;
+    std::vector<std::uint32_t> seen_;
+    std::vector<std::uint32_t> staticCandidates_;
+    std::vector<Endpoint> endpoints_;
+    std::vector<std::uint32_t> slotOf_; ///< Slot of each collidable by entity index, for matching endpoints
+    std::vector<std::uint8_t> listed_;
+    std::vector<std::uint32_t> active_;
+    std::vector<std::uint32_t> activePos_;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> overlaps_; ///< Sorted pairs (i, j), i < j, from the sweep
+    std::vector<std::uint32_t> overlapStart_;                       ///< Pairs of slot i start at overlapStart_[i]
+    bool sweepStale_ = true;                                        ///< Entries moved since the sweep, swept lazily
+    std::uint32_t stamp_ = 0;
 };
 
 } // namespace rtype::ecs
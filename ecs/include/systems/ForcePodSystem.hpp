@@ -10,6 +10,7 @@ class ForcePodSystem : public ISystem {
   public:
     ~ForcePodSystem() override = default;
     void update(GameEngine::Registry& registry, double dt) override;
+    void declareAccess(SystemAccess& access) const override;
 };
 
 } // namespace rtype::ecs
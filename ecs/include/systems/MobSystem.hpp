@@ -8,6 +8,7 @@ namespace rtype::ecs {
 class MobSystem : public ISystem {
   public:
     void update(GameEngine::Registry& registry, double dt) override;
+    void declareAccess(SystemAccess& access) const override;
 };
 
 } // namespace rtype::ecs
@@ -9,6 +9,7 @@ class MovementSystem : public ISystem {
   public:
     ~MovementSystem() override = default;
     void update(GameEngine::Registry& registry, double dt) override;
+    void declareAccess(SystemAccess& access) const override;
 };
 
 } // namespace rtype::ecs
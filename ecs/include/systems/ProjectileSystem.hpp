@@ -9,6 +9,7 @@ class ProjectileSystem : public ISystem {
   public:
     ~ProjectileSystem() override = default;
     void update(GameEngine::Registry& registry, double dt) override;
+    void declareAccess(SystemAccess& access) const override;
 };
 
 } // namespace rtype::ecs
@@ -9,6 +9,7 @@ class ScoreSystem : public ISystem {
   public:
     ~ScoreSystem() override = default;
     void update(GameEngine::Registry& registry, double dt) override;
+    void declareAccess(SystemAccess& access) const override;
 };
 
 } // namespace rtype::ecs
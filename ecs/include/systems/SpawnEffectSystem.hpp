@@ -10,6 +10,7 @@ class SpawnEffectSystem : public ISystem {
   public:
     ~SpawnEffectSystem() override = default;
     void update(GameEngine::Registry& registry, double dt) override;
+    void declareAccess(SystemAccess& access) const override;
 };
 
 } // namespace rtype::ecs
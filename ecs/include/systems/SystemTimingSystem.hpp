@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Registry.hpp"
+#include "SystemManager.hpp"
+
+namespace rtype::ecs {
+
+/// @brief Writes the SystemManager tick time percentiles into the SystemTimings overlay text
+class SystemTimingSystem {
+  public:
+    explicit SystemTimingSystem(const GameEngine::SystemManager& systemManager) : _systemManager(systemManager) {
+    }
+
+    void update(GameEngine::Registry& registry, double dt);
+
+  private:
+    const GameEngine::SystemManager& _systemManager;
+};
+
+} // namespace rtype::ecs
@@ -0,0 +1,86 @@
+#include "AabbKernel.hpp"
+#include <algorithm>
+
+#if defined(__AVX__)
+#define RTYPE_AABB_AVX
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define RTYPE_AABB_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace rtype::ecs {
+
+void AabbBlock::clear() {
+    _minX.clear();
+    _minY.clear();
+    _maxX.clear();
+    _maxY.clear();
+}
+
+void AabbBlock::push(float x, float y, float width, float height) {
+    _minX.push_back(x);
+    _minY.push_back(y);
+    _maxX.push_back(x + width);
+    _maxY.push_back(y + height);
+}
+
+std::uint64_t overlapMask(const AabbBlock& block, std::size_t first, float x, float y, float width, float height) {
+    if (first >= block.size()) {
+        return 0;
+    }
+    const std::size_t count = std::min<std::size_t>(64, block.size() - first);
+    const float* minX = block.minX() + first;
+    const float* minY = block.minY() + first;
+    const float* maxX = block.maxX() + first;
+    const float* maxY = block.maxY() + first;
+    const float right = x + width;
+    const float bottom = y + height;
+
+    std::uint64_t mask = 0;
+    std::size_t k = 0;
+#if defined(RTYPE_AABB_AVX)
+    const __m256 vx = _mm256_set1_ps(x);
+    const __m256 vy = _mm256_set1_ps(y);
+    const __m256 vright = _mm256_set1_ps(right);
+    const __m256 vbottom = _mm256_set1_ps(bottom);
+    for (; k + 8 <= count; k += 8) {
+        __m256 hit = _mm256_cmp_ps(vx, _mm256_loadu_ps(maxX + k), _CMP_LT_OQ);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(vright, _mm256_loadu_ps(minX + k), _CMP_GT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(vy, _mm256_loadu_ps(maxY + k), _CMP_LT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(vbottom, _mm256_loadu_ps(minY + k), _CMP_GT_OQ));
+        mask |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_ps(hit))) << k;
+    }
+#elif defined(RTYPE_AABB_SSE)
+    const __m128 vx = _mm_set1_ps(x);
+    const __m128 vy = _mm_set1_ps(y);
+    const __m128 vright = _mm_set1_ps(right);
+    const __m128 vbottom = _mm_set1_ps(bottom);
+    for (; k + 4 <= count; k += 4) {
+        __m128 hit = _mm_cmplt_ps(vx, _mm_loadu_ps(maxX + k));
+        hit = _mm_and_ps(hit, _mm_cmpgt_ps(vright, _mm_loadu_ps(minX + k)));
+        hit = _mm_and_ps(hit, _mm_cmplt_ps(vy, _mm_loadu_ps(maxY + k)));
+        hit = _mm_and_ps(hit, _mm_cmpgt_ps(vbottom, _mm_loadu_ps(minY + k)));
+        mask |= static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_ps(hit))) << k;
+    }
+#endif
+    // Scalar fallback, and the tail left over by the vector loops
+    for (; k < count; ++k) {
+        if (x < maxX[k] && right > minX[k] && y < maxY[k] && bottom > minY[k]) {
+            mask |= std::uint64_t{1} << k;
+        }
+    }
+    return mask;
+}
+
+const char* overlapKernelIsa() {
+#if defined(RTYPE_AABB_AVX)
+    return "avx";
+#elif defined(RTYPE_AABB_SSE)
+    return "sse";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace rtype::ecs
@@ -0,0 +1,107 @@
+#include "Assets.hpp"
+#include <array>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rtype::ecs {
+
+namespace {
+
+struct TextureNames {
+    std::mutex mutex;
+    // A deque keeps returned names valid while new ones are appended
+    std::deque<std::string> names{""};
+    std::unordered_map<std::string, TextureId> ids{{"", 0}};
+    // Published after the name is appended, so name() reads it without taking the mutex
+    std::array<std::atomic<const std::string*>, std::numeric_limits<TextureId>::max() + 1> published{};
+
+    TextureNames() {
+        published[0].store(&names.front(), std::memory_order_release);
+    }
+};
+
+TextureNames& textureNames() {
+    static TextureNames table;
+    return table;
+}
+
+struct ClipLibrary {
+    std::mutex mutex;
+    std::deque<AnimationClip> clips;
+    std::unordered_map<std::string, ClipId> ids;
+
+    ClipLibrary() {
+        add("", {});
+        add("ship_idle", {2});
+        add("ship_up", {2, 3, 4});
+        add("ship_down", {2, 1, 0});
+        add("explosion", {5, 4, 3, 2, 1, 0});
+    }
+
+    ClipId add(std::string_view name, std::vector<std::uint32_t> frames) {
+        auto [it, inserted] = ids.try_emplace(std::string(name), static_cast<ClipId>(clips.size()));
+        if (inserted) {
+            if (clips.size() > std::numeric_limits<ClipId>::max()) {
+                ids.erase(it);
+                throw std::length_error("Too many animation clips");
+            }
+            clips.push_back({std::string(name), std::move(frames)});
+        }
+        return it->second;
+    }
+};
+
+ClipLibrary& clipLibrary() {
+    static ClipLibrary library;
+    return library;
+}
+
+} // namespace
+
+TextureId TextureTable::intern(std::string_view name) {
+    TextureNames& table = textureNames();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto [it, inserted] = table.ids.try_emplace(std::string(name), static_cast<TextureId>(table.names.size()));
+    if (inserted) {
+        if (table.names.size() > std::numeric_limits<TextureId>::max()) {
+            table.ids.erase(it);
+            throw std::length_error("Too many distinct texture names");
+        }
+        table.published[it->second].store(&table.names.emplace_back(name), std::memory_order_release);
+    }
+    return it->second;
+}
+
+const std::string& TextureTable::name(TextureId id) {
+    static const std::string empty;
+    const std::string* name = textureNames().published[id].load(std::memory_order_acquire);
+    return name ? *name : empty;
+}
+
+ClipId AnimationClips::define(std::string_view name, std::vector<std::uint32_t> frames) {
+    ClipLibrary& library = clipLibrary();
+    std::lock_guard<std::mutex> lock(library.mutex);
+    return library.add(name, std::move(frames));
+}
+
+std::optional<ClipId> AnimationClips::find(std::string_view name) {
+    ClipLibrary& library = clipLibrary();
+    std::lock_guard<std::mutex> lock(library.mutex);
+    auto it = library.ids.find(std::string(name));
+    if (it == library.ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const AnimationClip& AnimationClips::get(ClipId id) {
+    ClipLibrary& library = clipLibrary();
+    std::lock_guard<std::mutex> lock(library.mutex);
+    return id < library.clips.size() ? library.clips[id] : library.clips[clips::None];
+}
+
+} // namespace rtype::ecs
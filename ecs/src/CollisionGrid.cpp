@@ -0,0 +1,50 @@
+#include "CollisionGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace rtype::ecs {
+
+CollisionGrid::CollisionGrid(float minX, float minY, float maxX, float maxY, float cellSize)
+    : _minX(minX), _minY(minY), _cellSize(cellSize) {
+    if (!(cellSize > 0.0f) || !(maxX > minX) || !(maxY > minY)) {
+        throw std::invalid_argument("CollisionGrid needs a positive cell size and a non-empty area");
+    }
+    _columns = static_cast<int>(std::ceil((maxX - minX) / cellSize));
+    _rows = static_cast<int>(std::ceil((maxY - minY) / cellSize));
+    _cells.resize(static_cast<std::size_t>(_columns * _rows));
+}
+
+void CollisionGrid::clear() {
+    for (auto& cell : _cells) {
+        cell.clear();
+    }
+}
+
+void CollisionGrid::insert(std::uint32_t id, float x, float y, float width, float height) {
+    const CellRange range = cellsOf(x, y, width, height);
+    for (int row = range.minRow; row <= range.maxRow; ++row) {
+        for (int col = range.minCol; col <= range.maxCol; ++col) {
+            _cells[static_cast<std::size_t>(row * _columns + col)].push_back(id);
+        }
+    }
+}
+
+CollisionGrid::CellRange CollisionGrid::cellsOf(float x, float y, float width, float height) const {
+    return {cellOf(std::min(x, x + width), _minX, _columns), cellOf(std::max(x, x + width), _minX, _columns),
+            cellOf(std::min(y, y + height), _minY, _rows), cellOf(std::max(y, y + height), _minY, _rows)};
+}
+
+int CollisionGrid::cellOf(float value, float min, int count) const {
+    const float cell = (value - min) / _cellSize;
+    // Written so that NaN lands in the first cell
+    if (!(cell >= 0.0f)) {
+        return 0;
+    }
+    if (cell >= static_cast<float>(count)) {
+        return count - 1;
+    }
+    return static_cast<int>(cell);
+}
+
+} // namespace rtype::ecs
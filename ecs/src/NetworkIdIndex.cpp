@@ -0,0 +1,40 @@
+#include "NetworkIdIndex.hpp"
+#include "components/NetworkId.hpp"
+
+namespace rtype::ecs {
+
+NetworkIdIndex::NetworkIdIndex(GameEngine::Registry& registry) : _registry(registry) {
+    _construct = registry.onConstruct<component::NetworkId>([this](GameEngine::Registry& owner, auto entity) {
+        _entities[owner.getComponent<component::NetworkId>(entity).id] = entity;
+    });
+    _destroy = registry.onDestroy<component::NetworkId>([this](GameEngine::Registry& owner, auto entity) {
+        auto it = _entities.find(owner.getComponent<component::NetworkId>(entity).id);
+        if (it != _entities.end() && it->second == entity) {
+            _entities.erase(it);
+        }
+    });
+    registry.view<component::NetworkId>().each(
+        [this](auto entity, const component::NetworkId& networkId) { _entities[networkId.id] = entity; });
+}
+
+NetworkIdIndex::~NetworkIdIndex() {
+    _registry.disconnect(_construct);
+    _registry.disconnect(_destroy);
+}
+
+NetworkIdIndex& NetworkIdIndex::of(GameEngine::Registry& registry) {
+    if (auto* index = registry.findContext<NetworkIdIndex>()) {
+        return *index;
+    }
+    return registry.emplaceContext<NetworkIdIndex>(registry);
+}
+
+std::optional<GameEngine::entity_t> NetworkIdIndex::find(std::uint32_t networkId) const {
+    auto it = _entities.find(networkId);
+    if (it == _entities.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace rtype::ecs
@@ -1,27 +1,344 @@
 #include "Registry.hpp"
+#include "CommandBuffer.hpp"
+#include "ThreadPool.hpp"
+#include <cstring>
+#include <exception>
+#include <thread>
 
 namespace GameEngine {
 
+namespace {
+
+// Per-thread command buffer override, set by SystemManager while systems of a stage run concurrently
+thread_local const Registry* boundRegistry = nullptr;
+thread_local CommandBuffer* boundCommands = nullptr;
+
+constexpr std::uint32_t SnapshotMagic = 0x504e5352; // "RSNP"
+constexpr std::uint32_t SnapshotVersion = 3;
+
+} // namespace
+
+Registry::Registry() = default;
+
+Registry::~Registry() {
+    // Context values go first, while they can still disconnect from the signals
+    _context.clear();
+}
+
 entity_t Registry::createEntity() {
-    entity_t entity = _nextEntity++;
-    _validEntities.insert(entity);
-    return entity;
+    settleReservations();
+    std::size_t index;
+    if (!_freeIndices.empty()) {
+        index = _freeIndices.back();
+        _freeIndices.pop_back();
+    } else {
+        index = _slotCount.fetch_add(1);
+        growSlots(index);
+    }
+    _alive[index] = 1;
+    return rtype::ecs::entity::make(index, _generations[index]);
+}
+
+entity_t Registry::reserveEntity() {
+    // Recycled slots are taken from the back of the free list without touching it, settleReservations() pops them
+    const std::size_t taken = _reservedFree.fetch_add(1);
+    if (taken < _freeIndices.size()) {
+        const std::size_t index = _freeIndices[_freeIndices.size() - 1 - taken];
+        return rtype::ecs::entity::make(index, _generations[index]);
+    }
+    return rtype::ecs::entity::make(_slotCount.fetch_add(1), 0);
+}
+
+void Registry::materializeEntity(entity_t entity) {
+    settleReservations();
+    const std::size_t index = rtype::ecs::entity::index(entity);
+    growSlots(index);
+    if (_generations[index] == rtype::ecs::entity::generation(entity)) {
+        _alive[index] = 1;
+    }
+}
+
+void Registry::settleReservations() {
+    const std::size_t taken = std::min(_reservedFree.exchange(0), _freeIndices.size());
+    _freeIndices.resize(_freeIndices.size() - taken);
+}
+
+void Registry::growSlots(std::size_t index) {
+    if (index >= _generations.size()) {
+        _generations.resize(index + 1, 0);
+        _alive.resize(index + 1, 0);
+    }
 }
 
 void Registry::destroyEntity(entity_t entity) {
-    if (_validEntities.find(entity) != _validEntities.end()) {
-        _validEntities.erase(entity);
+    if (!isValid(entity)) {
+        return;
+    }
+    _alive[rtype::ecs::entity::index(entity)] = 0;
+    for (std::size_t family = 0; family < _componentArrays.size(); ++family) {
+        auto& storage = _componentArrays[family];
+        if (storage && storage->contains(entity)) {
+            emit(family, &Signals::destroy, entity);
+            notifyGroupsDestroy(family, entity);
+            storage->remove(entity);
+        }
     }
+    std::size_t index = rtype::ecs::entity::index(entity);
+    ++_generations[index];
+    settleReservations();
+    _freeIndices.push_back(index);
 }
 
 bool Registry::isValid(entity_t entity) const {
-    return _validEntities.find(entity) != _validEntities.end();
+    const std::size_t index = rtype::ecs::entity::index(entity);
+    return index < _alive.size() && _alive[index] && _generations[index] == rtype::ecs::entity::generation(entity);
 }
 
 void Registry::clear() {
-    _validEntities.clear();
-    _componentArrays.clear();
-    _nextEntity = 0;
+    for (std::size_t family = 0; family < _signals.size() && family < _componentArrays.size(); ++family) {
+        const auto& storage = _componentArrays[family];
+        if (!storage || _signals[family].destroy.empty()) {
+            continue;
+        }
+        for (std::size_t index = 0; index < _alive.size(); ++index) {
+            const entity_t entity = rtype::ecs::entity::make(index, _generations[index]);
+            if (_alive[index] && storage->contains(entity)) {
+                emit(family, &Signals::destroy, entity);
+            }
+        }
+    }
+    // Every slot moves on, so handles reserved but never materialized go stale as well
+    if (_slotCount > 0) {
+        growSlots(_slotCount - 1);
+    }
+    for (std::size_t index = 0; index < _alive.size(); ++index) {
+        ++_generations[index];
+        _alive[index] = 0;
+    }
+    for (auto& storage : _componentArrays) {
+        if (storage) {
+            storage->clear();
+        }
+    }
+    for (auto& group : _groups) {
+        group->reset();
+    }
+    for (auto& query : _queries) {
+        query->reset();
+    }
+    if (_commands) {
+        _commands->clear();
+    }
+    // Reservations still pending are dropped with the command buffers
+    _reservedFree = 0;
+    _slotCount = _generations.size();
+    _freeIndices.clear();
+    for (std::size_t index = _generations.size(); index > 0; --index) {
+        _freeIndices.push_back(index - 1);
+    }
+}
+
+std::vector<Registry::QueryStats> Registry::queryStats() const {
+    std::vector<QueryStats> stats;
+    stats.reserve(_queries.size());
+    for (const auto& query : _queries) {
+        stats.push_back(query->stats());
+    }
+    return stats;
+}
+
+std::size_t Registry::componentMemoryUsage() const {
+    std::size_t total = 0;
+    for (const auto& storage : _componentArrays) {
+        if (storage) {
+            total += storage->memoryUsage();
+        }
+    }
+    return total;
+}
+
+void Registry::snapshot(std::vector<std::uint8_t>& out) const {
+    out.clear();
+    rtype::ecs::SnapshotWriter writer(out);
+    writer.write(SnapshotMagic);
+    writer.write(SnapshotVersion);
+    writer.write(static_cast<std::uint64_t>(_generations.size()));
+    writer.write(_generations.data(), _generations.size() * sizeof(std::uint32_t));
+    writer.write(static_cast<std::uint64_t>(_freeIndices.size()));
+    writer.write(_freeIndices.data(), _freeIndices.size() * sizeof(std::size_t));
+
+    writer.write(static_cast<std::uint32_t>(_snapshotTypes.size()));
+    for (const auto& type : _snapshotTypes) {
+        writer.writeString(type.name);
+        writer.write(type.size);
+        // Block length first so that a registry without this type can skip it
+        const std::size_t lengthAt = writer.offset();
+        writer.write(std::uint64_t{0});
+        type.save(*this, writer);
+        writer.overwrite(lengthAt, static_cast<std::uint64_t>(writer.offset() - lengthAt - sizeof(std::uint64_t)));
+    }
+}
+
+void Registry::restore(const std::vector<std::uint8_t>& blob) {
+    rtype::ecs::SnapshotReader reader(blob.data(), blob.size());
+    if (reader.read<std::uint32_t>() != SnapshotMagic || reader.read<std::uint32_t>() != SnapshotVersion) {
+        throw std::runtime_error("Not a registry snapshot or unsupported snapshot version");
+    }
+    clear();
+    try {
+        const auto slots = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        const std::uint8_t* generations = reader.take(slots, sizeof(std::uint32_t));
+        _generations.resize(slots);
+        _alive.assign(slots, 0);
+        _slotCount = slots;
+        std::memcpy(_generations.data(), generations, slots * sizeof(std::uint32_t));
+
+        const auto freeCount = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        const std::uint8_t* freeIndices = reader.take(freeCount, sizeof(std::size_t));
+        _freeIndices.resize(freeCount);
+        std::memcpy(_freeIndices.data(), freeIndices, freeCount * sizeof(std::size_t));
+
+        std::vector<bool> isFree(slots, false);
+        for (std::size_t index : _freeIndices) {
+            if (index >= slots || isFree[index]) {
+                throw std::runtime_error("Snapshot free list is corrupted");
+            }
+            isFree[index] = true;
+        }
+        for (std::size_t index = 0; index < slots; ++index) {
+            _alive[index] = isFree[index] ? 0 : 1;
+        }
+
+        const auto types = reader.read<std::uint32_t>();
+        for (std::uint32_t block = 0; block < types; ++block) {
+            const std::string name = reader.readString();
+            const auto size = reader.read<std::uint32_t>();
+            const auto length = static_cast<std::size_t>(reader.read<std::uint64_t>());
+            rtype::ecs::SnapshotReader payload(reader.take(length), length);
+
+            auto type = std::find_if(_snapshotTypes.begin(), _snapshotTypes.end(),
+                                     [&name](const SnapshotType& candidate) { return candidate.name == name; });
+            if (type == _snapshotTypes.end()) {
+                continue;
+            }
+            if (type->size != size) {
+                throw std::runtime_error("Snapshot component layout differs from this build: " + name);
+            }
+            type->load(*this, payload);
+            if (!payload.atEnd()) {
+                throw std::runtime_error("Snapshot component block is malformed: " + name);
+            }
+        }
+        if (!reader.atEnd()) {
+            throw std::runtime_error("Snapshot has trailing bytes");
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+void Registry::disconnect(Connection connection) {
+    for (auto& signals : _signals) {
+        for (auto* slots : {&signals.construct, &signals.destroy}) {
+            slots->erase(std::remove_if(slots->begin(), slots->end(),
+                                        [connection](const Slot& slot) { return slot.id == connection; }),
+                         slots->end());
+        }
+    }
+}
+
+Registry::Connection Registry::connect(std::size_t family, std::vector<Slot> Signals::*signal,
+                                       ComponentListener listener) {
+    if (family >= _signals.size()) {
+        _signals.resize(family + 1);
+    }
+    const Connection connection = _nextConnection++;
+    (_signals[family].*signal).push_back({connection, std::move(listener)});
+    return connection;
+}
+
+CommandBuffer& Registry::commands() {
+    if (boundRegistry == this) {
+        return *boundCommands;
+    }
+    if (!_commands) {
+        _commands = std::make_unique<CommandBuffer>(*this);
+    }
+    return *_commands;
+}
+
+CommandBuffer* Registry::bindThreadCommands(CommandBuffer* buffer) {
+    CommandBuffer* previous = boundRegistry == this ? boundCommands : nullptr;
+    boundRegistry = buffer ? this : nullptr;
+    boundCommands = buffer;
+    return previous;
+}
+
+void Registry::setThreadCount(std::size_t count) {
+    std::lock_guard<std::mutex> lock(_threadPoolMutex);
+    _threadCount = count;
+    _threadPool.reset();
+}
+
+std::size_t Registry::threadCount() const {
+    if (_threadCount != 0) {
+        return _threadCount;
+    }
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+ThreadPool& Registry::threadPool() {
+    std::lock_guard<std::mutex> lock(_threadPoolMutex);
+    if (!_threadPool) {
+        _threadPool = std::make_unique<ThreadPool>(threadCount() - 1);
+    }
+    return *_threadPool;
+}
+
+std::size_t Registry::chunkCount(std::size_t count, std::size_t minChunk) const {
+    const std::size_t threads = threadCount();
+    if (threads <= 1 || count == 0) {
+        return 1;
+    }
+    const std::size_t chunks = (count + std::max<std::size_t>(1, minChunk) - 1) / std::max<std::size_t>(1, minChunk);
+    // A few chunks per thread so that uneven chunks still balance
+    return std::min(chunks, threads * 4);
+}
+
+void Registry::runChunks(std::size_t chunks, const std::function<void(std::size_t)>& task) {
+    if (_chunksRunning.exchange(true)) {
+        // Another loop owns the chunk buffers (concurrent system or nested loop): stay on this thread
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            task(chunk);
+        }
+        return;
+    }
+    while (_chunkCommands.size() < chunks) {
+        _chunkCommands.push_back(std::make_unique<CommandBuffer>(*this));
+    }
+
+    std::vector<std::exception_ptr> errors(chunks);
+    threadPool().run(chunks, [&](std::size_t chunk) {
+        CommandBuffer* previous = bindThreadCommands(_chunkCommands[chunk].get());
+        try {
+            task(chunk);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+        bindThreadCommands(previous);
+    });
+
+    CommandBuffer& target = commands();
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        _chunkCommands[chunk]->appendTo(target);
+    }
+    _chunksRunning.store(false);
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 }
 
 } // namespace GameEngine
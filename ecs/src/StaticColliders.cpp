@@ -0,0 +1,112 @@
+#include "StaticColliders.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "components/Position.hpp"
+
+namespace rtype::ecs {
+
+StaticColliders::StaticColliders(std::vector<Collider> colliders, float tileWidth, float tileHeight)
+    : _colliders(std::move(colliders)), _tileWidth(tileWidth), _tileHeight(tileHeight) {
+    if (!(tileWidth > 0.0f) || !(tileHeight > 0.0f)) {
+        throw std::invalid_argument("StaticColliders needs positive tile dimensions");
+    }
+    if (_colliders.empty()) {
+        _tileStart.assign(1, 0);
+        return;
+    }
+
+    float maxX = _colliders.front().x;
+    float maxY = _colliders.front().y;
+    _minX = maxX;
+    _minY = maxY;
+    for (const auto& c : _colliders) {
+        _minX = std::min(_minX, c.x);
+        _minY = std::min(_minY, c.y);
+        maxX = std::max(maxX, c.x + c.width);
+        maxY = std::max(maxY, c.y + c.height);
+    }
+    _columns = std::max(1, static_cast<int>(std::ceil((maxX - _minX) / tileWidth)));
+    _rows = std::max(1, static_cast<int>(std::ceil((maxY - _minY) / tileHeight)));
+
+    // Two passes over the colliders: count per tile, then fill the ranges
+    const std::size_t tiles = static_cast<std::size_t>(_columns * _rows);
+    _tileStart.assign(tiles + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<std::uint32_t> cursor(_tileStart.begin(), _tileStart.end() - 1);
+        for (std::uint32_t index = 0; index < _colliders.size(); ++index) {
+            const auto& c = _colliders[index];
+            int firstCol, lastCol, firstRow, lastRow;
+            if (!tileSpan(c.x, c.x + c.width, _minX, _tileWidth, _columns, firstCol, lastCol) ||
+                !tileSpan(c.y, c.y + c.height, _minY, _tileHeight, _rows, firstRow, lastRow)) {
+                continue;
+            }
+            for (int row = firstRow; row <= lastRow; ++row) {
+                for (int col = firstCol; col <= lastCol; ++col) {
+                    const std::size_t tile = static_cast<std::size_t>(row * _columns + col);
+                    if (pass == 0) {
+                        ++_tileStart[tile + 1];
+                    } else {
+                        _tileItems[cursor[tile]++] = index;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (std::size_t tile = 0; tile < tiles; ++tile) {
+                _tileStart[tile + 1] += _tileStart[tile];
+            }
+            _tileItems.resize(_tileStart.back());
+        }
+    }
+}
+
+bool StaticColliders::follow(GameEngine::Registry& registry) {
+    // Destroyed entities never come back, so the scan resumes where it stopped last time
+    for (; _firstLive < _colliders.size(); ++_firstLive) {
+        const auto& c = _colliders[_firstLive];
+        if (registry.isValid(c.entity) && registry.hasComponent<component::Position>(c.entity)) {
+            const auto& pos = registry.getComponent<component::Position>(c.entity);
+            _offsetX = pos.x - c.x;
+            _offsetY = pos.y - c.y;
+            return true;
+        }
+    }
+    return false;
+}
+
+void StaticColliders::query(float x, float y, float width, float height, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    const float levelX = x - _offsetX;
+    const float levelY = y - _offsetY;
+    int firstCol, lastCol, firstRow, lastRow;
+    if (!tileSpan(levelX - _tileWidth, levelX + width + _tileWidth, _minX, _tileWidth, _columns, firstCol, lastCol) ||
+        !tileSpan(levelY - _tileHeight, levelY + height + _tileHeight, _minY, _tileHeight, _rows, firstRow,
+                  lastRow)) {
+        return;
+    }
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const std::size_t begin = static_cast<std::size_t>(row * _columns + firstCol);
+        const std::size_t end = static_cast<std::size_t>(row * _columns + lastCol) + 1;
+        out.insert(out.end(), _tileItems.begin() + _tileStart[begin], _tileItems.begin() + _tileStart[end]);
+    }
+    // Colliders spanning several of the tiles show up once per tile
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+bool StaticColliders::tileSpan(float min, float max, float origin, float tile, int count, int& first,
+                               int& last) const {
+    const float from = std::floor((std::min(min, max) - origin) / tile);
+    const float to = std::floor((std::max(min, max) - origin) / tile);
+    // Also rejects NaN
+    if (!(to >= 0.0f) || !(from < static_cast<float>(count))) {
+        return false;
+    }
+    first = from < 0.0f ? 0 : static_cast<int>(from);
+    last = std::min(count - 1, static_cast<int>(std::min(to, static_cast<float>(count))));
+    return true;
+}
+
+} // namespace rtype::ecs
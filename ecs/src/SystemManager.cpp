@@ -0,0 +1,103 @@
+#include "SystemManager.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace GameEngine {
+
+void SystemManager::update(Registry& registry, double dt) {
+    if (_mode == ExecutionMode::Serial || _systems.size() < 2) {
+        updateSerial(registry, dt);
+        return;
+    }
+    if (_preparedFor != &registry) {
+        for (const auto& access : _accesses) {
+            access.prepare(registry);
+        }
+        _stageCommands.clear();
+        _preparedFor = &registry;
+        updateSerial(registry, dt);
+        return;
+    }
+
+    CommandBuffer& commands = registry.commands();
+    commands.flush();
+    for (const auto& stage : stages()) {
+        if (stage.size() == 1) {
+            runSystem(stage.front(), registry, dt);
+            commands.flush();
+        } else {
+            runStage(registry, stage, dt);
+        }
+    }
+}
+
+const std::vector<std::vector<std::size_t>>& SystemManager::stages() {
+    if (!_stagesDirty) {
+        return _stages;
+    }
+    _stages.clear();
+    std::vector<std::size_t> stageOf(_systems.size(), 0);
+    for (std::size_t i = 0; i < _systems.size(); ++i) {
+        std::size_t stage = 0;
+        for (std::size_t j = 0; j < i; ++j) {
+            if (_accesses[i].conflictsWith(_accesses[j])) {
+                stage = std::max(stage, stageOf[j] + 1);
+            }
+        }
+        stageOf[i] = stage;
+        if (stage == _stages.size()) {
+            _stages.emplace_back();
+        }
+        _stages[stage].push_back(i);
+    }
+    _stagesDirty = false;
+    return _stages;
+}
+
+void SystemManager::updateSerial(Registry& registry, double dt) {
+    CommandBuffer& commands = registry.commands();
+    commands.flush();
+    for (std::size_t index = 0; index < _systems.size(); ++index) {
+        runSystem(index, registry, dt);
+        commands.flush();
+    }
+}
+
+void SystemManager::runSystem(std::size_t index, Registry& registry, double dt) {
+    if constexpr (SystemProfiler::Enabled) {
+        const auto start = SystemProfiler::begin();
+        _systems[index]->update(registry, dt);
+        _profiler.end(index, start);
+    } else {
+        _systems[index]->update(registry, dt);
+    }
+}
+
+void SystemManager::runStage(Registry& registry, const std::vector<std::size_t>& stage, double dt) {
+    while (_stageCommands.size() < stage.size()) {
+        _stageCommands.push_back(std::make_unique<CommandBuffer>(registry));
+    }
+
+    std::vector<std::exception_ptr> errors(stage.size());
+    registry.threadPool().run(stage.size(), [&](std::size_t slot) {
+        CommandBuffer* previous = registry.bindThreadCommands(_stageCommands[slot].get());
+        try {
+            runSystem(stage[slot], registry, dt);
+        } catch (...) {
+            errors[slot] = std::current_exception();
+        }
+        registry.bindThreadCommands(previous);
+    });
+
+    for (std::size_t slot = 0; slot < stage.size(); ++slot) {
+        _stageCommands[slot]->flush();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace GameEngine
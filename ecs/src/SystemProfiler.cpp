@@ -0,0 +1,79 @@
+#include "SystemProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace GameEngine {
+
+void SystemProfiler::addSystem(std::string name) {
+    _tracks.emplace_back();
+    _tracks.back().name = std::move(name);
+}
+
+void SystemProfiler::clear() {
+    _tracks.clear();
+}
+
+void SystemProfiler::end(std::size_t system, Clock::time_point start) {
+    const auto elapsed = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+    Track& track = _tracks[system];
+    track.samples[track.next] = {elapsed, static_cast<std::uint32_t>(_visited)};
+    track.next = (track.next + 1) % Capacity;
+    track.count = std::min(track.count + 1, Capacity);
+}
+
+std::vector<SystemStats> SystemProfiler::stats() const {
+    std::vector<SystemStats> result;
+    result.reserve(_tracks.size());
+    std::vector<float> sorted;
+    for (const auto& track : _tracks) {
+        SystemStats stats;
+        stats.name = track.name;
+        stats.samples = track.count;
+        if (track.count > 0) {
+            sorted.clear();
+            for (std::size_t i = 0; i < track.count; ++i) {
+                sorted.push_back(track.samples[i].micros);
+            }
+            std::sort(sorted.begin(), sorted.end());
+            auto percentile = [&sorted](double p) {
+                const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+                return static_cast<double>(sorted[std::max<std::size_t>(rank, 1) - 1]) / 1000.0;
+            };
+            stats.p50Ms = percentile(0.50);
+            stats.p95Ms = percentile(0.95);
+            stats.p99Ms = percentile(0.99);
+            stats.maxMs = static_cast<double>(sorted.back()) / 1000.0;
+            stats.entities = track.samples[(track.next + Capacity - 1) % Capacity].entities;
+        }
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+std::string SystemProfiler::readableName(const char* typeName) {
+    std::string name = typeName;
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(typeName, nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr) {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+    for (const char* prefix : {"class ", "struct "}) {
+        if (name.rfind(prefix, 0) == 0) {
+            name.erase(0, std::char_traits<char>::length(prefix));
+        }
+    }
+    const std::size_t scope = name.rfind("::");
+    if (scope != std::string::npos) {
+        name.erase(0, scope + 2);
+    }
+    return name;
+}
+
+} // namespace GameEngine
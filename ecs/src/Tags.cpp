@@ -0,0 +1,64 @@
+#include "Tags.hpp"
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rtype::ecs {
+
+namespace {
+
+struct TagNames {
+    std::mutex mutex;
+    // A deque keeps returned names valid while new ones are appended
+    std::deque<std::string> names;
+    std::unordered_map<std::string, TagId> ids;
+
+    TagNames() {
+        for (std::string_view name : tags::Known) {
+            ids.emplace(std::string(name), static_cast<TagId>(names.size()));
+            names.emplace_back(name);
+        }
+    }
+};
+
+TagNames& tagNames() {
+    static TagNames table;
+    return table;
+}
+
+} // namespace
+
+TagId TagTable::intern(std::string_view name) {
+    TagNames& table = tagNames();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto [it, inserted] = table.ids.try_emplace(std::string(name), static_cast<TagId>(table.names.size()));
+    if (inserted) {
+        if (table.names.size() > std::numeric_limits<TagId>::max()) {
+            table.ids.erase(it);
+            throw std::length_error("Too many distinct tag names");
+        }
+        table.names.emplace_back(name);
+    }
+    return it->second;
+}
+
+std::optional<TagId> TagTable::find(std::string_view name) {
+    TagNames& table = tagNames();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.ids.find(std::string(name));
+    if (it == table.ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::string& TagTable::name(TagId id) {
+    static const std::string empty;
+    TagNames& table = tagNames();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return id < table.names.size() ? table.names[id] : empty;
+}
+
+} // namespace rtype::ecs
@@ -0,0 +1,74 @@
+#include "ThreadPool.hpp"
+
+namespace GameEngine {
+
+ThreadPool::ThreadPool(std::size_t workers) {
+    _workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        _workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    if (_workers.empty() || count == 1 || _running.exchange(true)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _count = count;
+        _next.store(0);
+        _busy = _workers.size();
+        ++_generation;
+    }
+    _wake.notify_all();
+    drain();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return _busy == 0; });
+    _task = nullptr;
+    _running.store(false);
+}
+
+void ThreadPool::workerLoop() {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this, seen]() { return _stop || _generation != seen; });
+            if (_stop) {
+                return;
+            }
+            seen = _generation;
+        }
+        drain();
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_busy == 0) {
+            _done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::drain() {
+    for (std::size_t i = _next.fetch_add(1); i < _count; i = _next.fetch_add(1)) {
+        (*_task)(i);
+    }
+}
+
+} // namespace GameEngine
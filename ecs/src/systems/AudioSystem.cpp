@@ -5,6 +5,7 @@
 #include "components/Velocity.hpp"
 #include "components/Drawable.hpp"
 #include "components/Tag.hpp"
+#include "CommandBuffer.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -67,18 +68,9 @@ void AudioSystem::update(GameEngine::Registry& registry, double) {
 
     try {
         auto event_view = registry.view<component::AudioEvent>();
-        std::vector<GameEngine::entity_t> entities_to_process;
-
-        for (auto entity : event_view) {
-            entities_to_process.push_back(static_cast<GameEngine::entity_t>(entity));
-        }
-
-        for (auto entity : entities_to_process) {
-            if (!registry.isValid(entity))
-                continue;
-
-            auto& audio_event = registry.getComponent<component::AudioEvent>(entity);
+        auto& commands = registry.commands();
 
+        event_view.each([&](auto entity, component::AudioEvent& audio_event) {
             // Handle special music events
             if (audio_event.type == component::AudioEventType::BOSS_MUSIC_START) {
                 switchToBossMusic();
@@ -89,17 +81,17 @@ void AudioSystem::update(GameEngine::Registry& registry, double) {
                 }
             }
 
-            registry.removeComponent<component::AudioEvent>(entity);
-
             bool has_other_components = registry.hasComponent<component::Position>(entity) ||
                                         registry.hasComponent<component::Velocity>(entity) ||
                                         registry.hasComponent<component::Drawable>(entity) ||
                                         registry.hasComponent<component::Tag>(entity);
 
-            if (!has_other_components) {
-                registry.destroyEntity(entity);
+            if (has_other_components) {
+                commands.remove<component::AudioEvent>(entity);
+            } else {
+                commands.destroy(entity);
             }
-        }
+        });
     } catch (const std::exception& e) {
         std::cerr << "AudioSystem error processing AudioEvent: " << e.what() << std::endl;
     }
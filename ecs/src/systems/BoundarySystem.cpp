@@ -7,8 +7,8 @@
 #include "components/MapBounds.hpp"
 #include "GameConstants.hpp"
 #include "components/Tag.hpp"
-#include "Registry.hpp"
-#include <vector>
+#include "CommandBuffer.hpp"
+#include "SystemAccess.hpp"
 
 #include "utils/GameConfig.hpp"
 
@@ -22,22 +22,16 @@ void BoundarySystem::update(GameEngine::Registry& registry, double dt) {
     float maxX = rtype::config::MAP_MAX_X;
     float maxY = rtype::config::MAP_MAX_Y;
 
-    try {
-        auto mapBoundsView = registry.view<component::MapBounds>();
-        for (auto entity : mapBoundsView) {
-            auto& bounds = registry.getComponent<component::MapBounds>(static_cast<std::size_t>(entity));
-            minX = bounds.minX;
-            minY = bounds.minY;
-            maxX = bounds.maxX;
-            maxY = bounds.maxY;
-            break;
-        }
-    } catch (const std::exception&) {
+    if (const auto* bounds = registry.findContext<component::MapBounds>()) {
+        minX = bounds->minX;
+        minY = bounds->minY;
+        maxX = bounds->maxX;
+        maxY = bounds->maxY;
     }
 
     auto view = registry.view<component::Position>();
 
-    std::vector<GameEngine::entity_t> entities_to_destroy;
+    auto& commands = registry.commands();
 
     view.each([&](const auto entity, component::Position& pos) {
         float width = 0.0f;
@@ -52,12 +46,14 @@ void BoundarySystem::update(GameEngine::Registry& registry, double dt) {
         bool is_player = false;
         if (registry.hasComponent<component::Tag>(static_cast<std::size_t>(entity))) {
             const auto& tag = registry.getComponent<component::Tag>(static_cast<std::size_t>(entity));
-            if (tag.name == "Player") {
+            if (tag.id == tags::Player) {
                 is_player = true;
             }
         }
 
         if (is_player) {
+            const float oldX = pos.x;
+            const float oldY = pos.y;
             if (pos.x < minX)
                 pos.x = minX;
             if (pos.x + width > maxX)
@@ -66,6 +62,9 @@ void BoundarySystem::update(GameEngine::Registry& registry, double dt) {
                 pos.y = minY;
             if (pos.y + height > maxY)
                 pos.y = maxY - height;
+            if (pos.x != oldX || pos.y != oldY) {
+                registry.markChanged<component::Position>(entity);
+            }
             return;
         }
 
@@ -81,13 +80,14 @@ void BoundarySystem::update(GameEngine::Registry& registry, double dt) {
 
         if (pos.x + width < minX - buffer || pos.x > maxX + rightBuffer || pos.y + height < minY - buffer ||
             pos.y > maxY + buffer) {
-            entities_to_destroy.push_back(static_cast<GameEngine::entity_t>(entity));
+            commands.destroy(entity);
         }
     });
+}
 
-    for (auto entity : entities_to_destroy) {
-        registry.destroyEntity(entity);
-    }
+void BoundarySystem::declareAccess(SystemAccess& access) const {
+    access.reads<component::MapBounds, component::HitBox, component::Tag, component::Projectile>()
+        .writes<component::Position>();
 }
 
 } // namespace rtype::ecs
@@ -24,135 +24,408 @@
 #include "components/AudioEvent.hpp"
 #include "components/HitFlash.hpp"
 #include "components/StageCleared.hpp"
+#include "utils/GameConfig.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
 
 namespace rtype::ecs {
 
 void spawnForcePodItem(GameEngine::Registry& registry, float x, float y);
 void spawnForcePodCompanion(GameEngine::Registry& registry, GameEngine::entity_t playerId);
 
+namespace {
+
+using Collidables = GameEngine::Registry::Group<GameEngine::get_t<component::Position>, component::HitBox,
+                                                component::Collidable>;
+
+Collidables collidablesOf(GameEngine::Registry& registry) {
+    return registry.group<component::HitBox, component::Collidable>(GameEngine::get_t<component::Position>{});
+}
+
+// x extent as swept; NaN boxes never collide and are parked at -inf so they cannot break the sort order
+std::pair<float, float> xSpan(float x, float width) {
+    const float right = x + width;
+    if (std::isnan(x) || std::isnan(right)) {
+        return {-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+    }
+    return {std::min(x, right), std::max(x, right)};
+}
+
+} // namespace
+
+CollisionSystem::CollisionSystem(Broadphase mode)
+    : broadphase_(mode),
+      grid_(config::MAP_MIN_X, config::MAP_MIN_Y, config::MAP_MAX_X, config::MAP_MAX_Y, GridCellSize) {
+}
+
 void CollisionSystem::update(GameEngine::Registry& registry, double dt) {
     (void)dt;
 
     bool friendly_fire_enabled = false;
-    auto rules_view = registry.view<component::GameRulesComponent>();
-    for (auto entity : rules_view) {
-        const auto& rules_comp = registry.getComponent<component::GameRulesComponent>(entity);
-        friendly_fire_enabled = rules_comp.rules.friendly_fire_enabled;
-        break;
+    if (const auto* rules_comp = registry.findContext<component::GameRulesComponent>()) {
+        friendly_fire_enabled = rules_comp->rules.friendly_fire_enabled;
     }
 
-    auto view = registry.view<component::Position, component::HitBox, component::Collidable>();
+    auto collidables = collidablesOf(registry);
+    entities_.assign(collidables.data(), collidables.data() + collidables.size());
 
-    std::vector<GameEngine::entity_t> entities;
-    for (auto entity : view) {
-        entities.push_back(static_cast<GameEngine::entity_t>(entity));
+    if (auto* statics = registry.findContext<StaticColliders>()) {
+        RunStatic(registry, *statics, friendly_fire_enabled);
     }
+    if (broadphase_ == Broadphase::BruteForce) {
+        RunBruteForce(registry, friendly_fire_enabled);
+    } else {
+        RunIndexed(registry, friendly_fire_enabled);
+    }
+}
 
-    for (size_t i = 0; i < entities.size(); ++i) {
-        auto entity1 = entities[i];
-        if (!registry.isValid(entity1)) {
+// Level obstacles used to be the first collidables created, so their pairs came first; they still do
+void CollisionSystem::RunStatic(GameEngine::Registry& registry, StaticColliders& statics, bool friendly_fire_enabled) {
+    if (!statics.follow(registry)) {
+        return;
+    }
+    auto collidables = collidablesOf(registry);
+
+    for (auto entity1 : entities_) {
+        if (!collidables.contains(entity1)) {
             continue;
         }
-
-        if (!registry.hasComponent<component::Position>(entity1) ||
-            !registry.hasComponent<component::HitBox>(entity1) ||
-            !registry.hasComponent<component::Collidable>(entity1)) {
+        const auto collidable1 = registry.getComponent<component::Collidable>(entity1);
+        if (!collidable1.is_active ||
+            !ShouldCollide(collidable1.layer, component::CollisionLayer::Obstacle, friendly_fire_enabled)) {
             continue;
         }
 
-        auto& pos1 = view.get<component::Position>(entity1);
-        auto& hitbox1 = view.get<component::HitBox>(entity1);
-        auto& collidable1 = view.get<component::Collidable>(entity1);
+        const auto& pos1 = registry.getComponent<component::Position>(entity1);
+        const auto& hitbox1 = registry.getComponent<component::HitBox>(entity1);
+        statics.query(pos1.x, pos1.y, hitbox1.width, hitbox1.height, staticCandidates_);
+        for (std::uint32_t index : staticCandidates_) {
+            const auto obstacle = statics.collider(index).entity;
+            if (!registry.isValid(obstacle) || !registry.hasComponent<component::Position>(obstacle) ||
+                !registry.hasComponent<component::HitBox>(obstacle)) {
+                continue;
+            }
 
-        if (!collidable1.is_active) {
+            // Fetched per obstacle: a push moves entity 1
+            const auto& pos = registry.getComponent<component::Position>(entity1);
+            const auto& hitbox = registry.getComponent<component::HitBox>(entity1);
+            const auto& posO = registry.getComponent<component::Position>(obstacle);
+            const auto& boxO = registry.getComponent<component::HitBox>(obstacle);
+            if (!CheckAABBCollision(pos.x, pos.y, hitbox.width, hitbox.height, posO.x, posO.y, boxO.width,
+                                    boxO.height)) {
+                continue;
+            }
+            HandleCollision(registry, entity1, obstacle, collidable1.layer, component::CollisionLayer::Obstacle);
+            if (!collidables.contains(entity1))
+                break; // Entity 1 destroyed, stop inner loop
+        }
+    }
+}
+
+void CollisionSystem::RunBruteForce(GameEngine::Registry& registry, bool friendly_fire_enabled) {
+    auto collidables = collidablesOf(registry);
+
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        auto entity1 = entities_[i];
+        if (!collidables.contains(entity1)) {
             continue;
         }
 
-        for (size_t j = i + 1; j < entities.size(); ++j) {
-            auto entity2 = entities[j];
-            if (!registry.isValid(entity2)) {
-                continue;
-            }
+        if (!registry.getComponent<component::Collidable>(entity1).is_active) {
+            continue;
+        }
 
-            if (!registry.hasComponent<component::Position>(entity2) ||
-                !registry.hasComponent<component::HitBox>(entity2) ||
-                !registry.hasComponent<component::Collidable>(entity2)) {
+        for (size_t j = i + 1; j < entities_.size(); ++j) {
+            auto entity2 = entities_[j];
+            if (!collidables.contains(entity2)) {
                 continue;
             }
 
-            auto& pos2 = view.get<component::Position>(entity2);
-            auto& hitbox2 = view.get<component::HitBox>(entity2);
-            auto& collidable2 = view.get<component::Collidable>(entity2);
+            if (TestPair(registry, entity1, entity2, friendly_fire_enabled) && !collidables.contains(entity1))
+                break; // Entity 1 destroyed, stop inner loop
+        }
+    }
+}
+
+// Visits the same pairs as RunBruteForce, in the same order, minus those the broadphase rules out. Handling a
+// collision only moves or destroys the pair itself, and the entities it creates are not in this tick's snapshot, so
+// only the pair's entries are re-registered before going on.
+void CollisionSystem::RunIndexed(GameEngine::Registry& registry, bool friendly_fire_enabled) {
+    auto collidables = collidablesOf(registry);
+    const component::CollisionMatrix& matrix =
+        friendly_fire_enabled ? component::FriendlyFireCollisionMatrix : component::DefaultCollisionMatrix;
+
+    entries_.resize(entities_.size());
+    seen_.assign(entities_.size(), 0);
+    stamp_ = 0;
+    grid_.clear();
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        if (!collidables.contains(entities_[i])) {
+            continue; // Destroyed by an obstacle in RunStatic
+        }
+        entries_[i] = CurrentEntry(registry, entities_[i]);
+        Register(static_cast<std::uint32_t>(i));
+    }
+    // Boxes moved by a collision mark the sweep stale; the next lookup sweeps again, a short insertion sort since
+    // only those endpoints are out of place
+    auto gather = [&](std::size_t index, std::size_t after) {
+        if (broadphase_ == Broadphase::SweepAndPrune && sweepStale_) {
+            Sweep(registry, matrix);
+        }
+        GatherCandidates(index, after, matrix);
+        NarrowCandidates(index);
+    };
+
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        auto entity1 = entities_[i];
+        if (!collidables.contains(entity1)) {
+            continue;
+        }
 
-            if (!collidable2.is_active) {
+        if (!registry.getComponent<component::Collidable>(entity1).is_active) {
+            continue;
+        }
+
+        gather(i, i);
+        for (size_t k = 0; k < candidates_.size(); ++k) {
+            const std::size_t j = candidates_[k];
+            auto entity2 = entities_[j];
+            if (!collidables.contains(entity2)) {
                 continue;
             }
 
-            if (!ShouldCollide(collidable1.layer, collidable2.layer, friendly_fire_enabled)) {
+            if (!TestPair(registry, entity1, entity2, friendly_fire_enabled)) {
                 continue;
             }
+            RefreshEntry(registry, j);
+            if (!collidables.contains(entity1))
+                break; // Entity 1 destroyed, stop inner loop
 
-            if (CheckAABBCollision(pos1.x, pos1.y, hitbox1.width, hitbox1.height, pos2.x, pos2.y, hitbox2.width,
-                                   hitbox2.height)) {
-                HandleCollision(registry, entity1, entity2, collidable1.layer, collidable2.layer);
-                if (!registry.isValid(entity1))
-                    break; // Entity 1 destroyed, stop inner loop
+            if (RefreshEntry(registry, i)) {
+                gather(i, j);
+                k = static_cast<size_t>(-1); // Restart on the fresh candidates, all after j
             }
         }
     }
 }
 
-bool CollisionSystem::CheckAABBCollision(float x1, float y1, float w1, float h1, float x2, float y2, float w2,
-                                         float h2) {
-    return (x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2);
+void CollisionSystem::Register(std::uint32_t index) {
+    const Entry& entry = entries_[index];
+    if (broadphase_ == Broadphase::SweepAndPrune) {
+        sweepStale_ = true; // Picked up by the next Sweep
+        return;
+    }
+    if (broadphase_ == Broadphase::Grid) {
+        grid_.insert(index, entry.x, entry.y, entry.width, entry.height);
+        return;
+    }
+    auto& bucket = buckets_[static_cast<std::size_t>(entry.layer)];
+    bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), index), index);
 }
 
-bool CollisionSystem::ShouldCollide(component::CollisionLayer layer1, component::CollisionLayer layer2,
-                                    bool friendly_fire_enabled) {
-    using CL = component::CollisionLayer;
+void CollisionSystem::GatherCandidates(std::size_t index, std::size_t after, const component::CollisionMatrix& matrix) {
+    candidates_.clear();
+    if (++stamp_ == 0) {
+        std::fill(seen_.begin(), seen_.end(), 0);
+        stamp_ = 1;
+    }
+    const std::uint8_t mask = matrix[static_cast<std::size_t>(entries_[index].layer)];
+    // Entries re-registered during the tick leave stale copies behind, filtered out by the stamp and layer checks
+    auto visit = [&](std::uint32_t candidate) {
+        const int layer = static_cast<int>(entries_[candidate].layer);
+        if (candidate > after && seen_[candidate] != stamp_ && ((mask >> layer) & 1)) {
+            seen_[candidate] = stamp_;
+            candidates_.push_back(candidate);
+        }
+    };
+
+    if (broadphase_ == Broadphase::Grid) {
+        const Entry& entry = entries_[index];
+        grid_.query(entry.x, entry.y, entry.width, entry.height, visit);
+    } else if (broadphase_ == Broadphase::SweepAndPrune) {
+        for (std::uint32_t k = overlapStart_[index]; k < overlapStart_[index + 1]; ++k) {
+            visit(overlaps_[k].second);
+        }
+    } else {
+        for (std::size_t layer = 0; layer < buckets_.size(); ++layer) {
+            if ((mask >> layer) & 1) {
+                const auto& bucket = buckets_[layer];
+                std::for_each(std::upper_bound(bucket.begin(), bucket.end(), static_cast<std::uint32_t>(after)),
+                              bucket.end(), visit);
+            }
+        }
+    }
+    std::sort(candidates_.begin(), candidates_.end());
+}
 
-    if (layer1 == CL::None || layer2 == CL::None) {
-        return false;
+// Entries are current here, so a box the kernel rejects is one CheckAABBCollision would reject in TestPair
+void CollisionSystem::NarrowCandidates(std::size_t index) {
+    candidateBoxes_.clear();
+    for (std::uint32_t candidate : candidates_) {
+        const Entry& entry = entries_[candidate];
+        candidateBoxes_.push(entry.x, entry.y, entry.width, entry.height);
     }
 
-    if (layer1 == CL::Player && layer2 == CL::Enemy)
-        return true;
-    if (layer1 == CL::Enemy && layer2 == CL::Player)
-        return true;
+    const Entry& entry = entries_[index];
+    std::size_t kept = 0;
+    for (std::size_t first = 0; first < candidates_.size(); first += 64) {
+        std::uint64_t hits = overlapMask(candidateBoxes_, first, entry.x, entry.y, entry.width, entry.height);
+        for (; hits != 0; hits &= hits - 1) {
+            candidates_[kept++] = candidates_[first + static_cast<std::size_t>(std::countr_zero(hits))];
+        }
+    }
+    candidates_.resize(kept);
+}
 
-    if (layer1 == CL::Player && layer2 == CL::EnemyProjectile)
-        return true;
-    if (layer1 == CL::EnemyProjectile && layer2 == CL::Player)
-        return true;
+// Entities mostly drift along x a little every tick, so last tick's order is nearly sorted and the insertion sort
+// only moves the few endpoints that crossed a neighbour
+void CollisionSystem::Sweep(GameEngine::Registry& registry, const component::CollisionMatrix& matrix) {
+    constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+    auto collidables = collidablesOf(registry);
+    for (std::size_t i = 0; i < entities_.size(); ++i) {
+        const std::size_t index = entity::index(entities_[i]);
+        if (index >= slotOf_.size()) {
+            slotOf_.resize(index + 1, none);
+        }
+        slotOf_[index] = collidables.contains(entities_[i]) ? static_cast<std::uint32_t>(i) : none;
+    }
 
-    if (layer1 == CL::Enemy && layer2 == CL::PlayerProjectile)
-        return true;
-    if (layer1 == CL::PlayerProjectile && layer2 == CL::Enemy)
-        return true;
+    // Drop the endpoints of entities that left the collidables and refresh the others, keeping their order
+    listed_.assign(entities_.size(), 0);
+    std::size_t kept = 0;
+    for (Endpoint endpoint : endpoints_) {
+        const std::size_t index = entity::index(endpoint.entity);
+        const std::uint32_t slot = index < slotOf_.size() ? slotOf_[index] : none;
+        if (slot >= entities_.size() || entities_[slot] != endpoint.entity) {
+            continue;
+        }
+        const auto [min, max] = xSpan(entries_[slot].x, entries_[slot].width);
+        endpoint.value = endpoint.isMax ? max : min;
+        endpoint.slot = slot;
+        listed_[slot] = 1;
+        endpoints_[kept++] = endpoint;
+    }
+    endpoints_.resize(kept);
+    for (std::uint32_t slot = 0; slot < entities_.size(); ++slot) {
+        if (!listed_[slot] && slotOf_[entity::index(entities_[slot])] == slot) {
+            const auto [min, max] = xSpan(entries_[slot].x, entries_[slot].width);
+            endpoints_.push_back({min, false, slot, entities_[slot]});
+            endpoints_.push_back({max, true, slot, entities_[slot]});
+        }
+    }
 
-    if (layer1 == CL::Player && layer2 == CL::PowerUp)
-        return true;
-    if (layer1 == CL::PowerUp && layer2 == CL::Player)
-        return true;
+    // Starts before ends on ties, so touching extents still pair up; TestPair rejects them
+    auto before = [](const Endpoint& a, const Endpoint& b) {
+        return a.value < b.value || (a.value == b.value && !a.isMax && b.isMax);
+    };
+    if (endpoints_.size() - kept > kept) {
+        std::sort(endpoints_.begin(), endpoints_.end(), before); // Mostly newcomers, e.g. the first tick
+    } else {
+        for (std::size_t i = 1; i < endpoints_.size(); ++i) {
+            const Endpoint endpoint = endpoints_[i];
+            std::size_t j = i;
+            for (; j > 0 && before(endpoint, endpoints_[j - 1]); --j) {
+                endpoints_[j] = endpoints_[j - 1];
+            }
+            endpoints_[j] = endpoint;
+        }
+    }
 
-    if (layer1 == CL::Obstacle || layer2 == CL::Obstacle)
-        return true;
+    overlaps_.clear();
+    active_.clear();
+    activePos_.resize(entities_.size());
+    for (const Endpoint& endpoint : endpoints_) {
+        if (endpoint.isMax) {
+            const std::uint32_t last = active_.back();
+            active_[activePos_[endpoint.slot]] = last;
+            activePos_[last] = activePos_[endpoint.slot];
+            active_.pop_back();
+            continue;
+        }
+        const std::uint8_t mask = matrix[static_cast<std::size_t>(entries_[endpoint.slot].layer)];
+        for (std::uint32_t other : active_) {
+            if ((mask >> static_cast<int>(entries_[other].layer)) & 1) {
+                overlaps_.emplace_back(std::min(other, endpoint.slot), std::max(other, endpoint.slot));
+            }
+        }
+        activePos_[endpoint.slot] = static_cast<std::uint32_t>(active_.size());
+        active_.push_back(endpoint.slot);
+    }
+    std::sort(overlaps_.begin(), overlaps_.end());
 
-    if (layer1 == CL::PlayerProjectile && layer2 == CL::EnemyProjectile)
-        return true;
-    if (layer1 == CL::EnemyProjectile && layer2 == CL::PlayerProjectile)
-        return true;
+    overlapStart_.assign(entities_.size() + 1, 0);
+    for (const auto& overlap : overlaps_) {
+        ++overlapStart_[overlap.first + 1];
+    }
+    for (std::size_t i = 0; i < entities_.size(); ++i) {
+        overlapStart_[i + 1] += overlapStart_[i];
+    }
+    sweepStale_ = false;
+}
+
+bool CollisionSystem::RefreshEntry(GameEngine::Registry& registry, std::size_t index) {
+    if (!collidablesOf(registry).contains(entities_[index])) {
+        return false;
+    }
+    const Entry entry = CurrentEntry(registry, entities_[index]);
+    if (entry == entries_[index]) {
+        return false;
+    }
+    // Buckets only care about the layer, grid cells and the sweep about the box
+    const bool relayered = entry.layer != entries_[index].layer;
+    entries_[index] = entry;
+    if (broadphase_ != Broadphase::LayerBuckets || relayered) {
+        Register(static_cast<std::uint32_t>(index));
+    }
+    return true;
+}
+
+CollisionSystem::Entry CollisionSystem::CurrentEntry(GameEngine::Registry& registry,
+                                                     GameEngine::entity_t entity) const {
+    const auto& pos = registry.getComponent<component::Position>(entity);
+    const auto& hitbox = registry.getComponent<component::HitBox>(entity);
+    return {pos.x, pos.y, hitbox.width, hitbox.height, registry.getComponent<component::Collidable>(entity).layer};
+}
+
+bool CollisionSystem::TestPair(GameEngine::Registry& registry, GameEngine::entity_t entity1,
+                               GameEngine::entity_t entity2, bool friendly_fire_enabled) {
+    // Fetched per pair: HandleCollision may add or destroy entities, which moves packed components
+    auto& pos1 = registry.getComponent<component::Position>(entity1);
+    auto& hitbox1 = registry.getComponent<component::HitBox>(entity1);
+    auto& collidable1 = registry.getComponent<component::Collidable>(entity1);
+    auto& pos2 = registry.getComponent<component::Position>(entity2);
+    auto& hitbox2 = registry.getComponent<component::HitBox>(entity2);
+    auto& collidable2 = registry.getComponent<component::Collidable>(entity2);
+
+    if (!collidable2.is_active) {
+        return false;
+    }
 
-    if (friendly_fire_enabled) {
-        if (layer1 == CL::Player && layer2 == CL::Player)
-            return true;
-        if (layer1 == CL::Player && layer2 == CL::PlayerProjectile)
-            return true;
-        if (layer1 == CL::PlayerProjectile && layer2 == CL::Player)
-            return true;
+    if (!ShouldCollide(collidable1.layer, collidable2.layer, friendly_fire_enabled)) {
+        return false;
     }
 
-    return false;
+    if (!CheckAABBCollision(pos1.x, pos1.y, hitbox1.width, hitbox1.height, pos2.x, pos2.y, hitbox2.width,
+                            hitbox2.height)) {
+        return false;
+    }
+    HandleCollision(registry, entity1, entity2, collidable1.layer, collidable2.layer);
+    return true;
+}
+
+bool CollisionSystem::CheckAABBCollision(float x1, float y1, float w1, float h1, float x2, float y2, float w2,
+                                         float h2) {
+    return (x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2);
+}
+
+bool CollisionSystem::ShouldCollide(component::CollisionLayer layer1, component::CollisionLayer layer2,
+                                    bool friendly_fire_enabled) {
+    return component::layersInteract(layer1, layer2, friendly_fire_enabled);
 }
 
 void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine::entity_t entity1,
@@ -191,7 +464,7 @@ void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine
         bool is_charged = false;
         if (registry.hasComponent<component::Tag>(projectile_entity)) {
             const auto& tag = registry.getComponent<component::Tag>(projectile_entity);
-            if (tag.name.find("charge") != std::string::npos) {
+            if (tags::isChargeShot(tag.id)) {
                 is_charged = true;
             }
         }
@@ -205,7 +478,7 @@ void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine
             health.hp -= 25;
 
             if (registry.hasComponent<component::HitFlash>(enemy_entity)) {
-                auto& flash = registry.getComponent<component::HitFlash>(enemy_entity);
+                auto& flash = registry.patch<component::HitFlash>(enemy_entity);
                 flash.active = true;
                 flash.timer = flash.duration;
             } else {
@@ -216,25 +489,22 @@ void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine
                 bool is_boss = false;
                 if (registry.hasComponent<component::Tag>(enemy_entity)) {
                     const auto& enemyTag = registry.getComponent<component::Tag>(enemy_entity);
-                    if (enemyTag.name == "Boss_1") {
+                    if (enemyTag.id == tags::Boss1) {
                         is_boss = true;
                         auto world_entity = registry.createEntity();
                         registry.addComponent<component::StageCleared>(world_entity, 1);
                         std::cout << "[STAGE CLEARED] Boss_1 defeated!" << std::endl;
 
-                        auto spawnerView = registry.view<component::EnemySpawner>();
-                        for (auto spawnerEntity : spawnerView) {
-                            auto& spawner = registry.getComponent<component::EnemySpawner>(spawnerEntity);
-                            spawner.currentLevel++;
-                            spawner.currentWave = 0;
-                            spawner.waveTimer = 0;
-                            spawner.currentEnemyIndex = 0;
-                            spawner.bossWarningActive = false;
-                            spawner.bossWarningTimer = 0.0f;
-                            std::cout << "Advancing to Level " << spawner.currentLevel + 1 << std::endl;
-                            break;
+                        if (auto* spawner = registry.findContext<component::EnemySpawner>()) {
+                            spawner->currentLevel++;
+                            spawner->currentWave = 0;
+                            spawner->waveTimer = 0;
+                            spawner->currentEnemyIndex = 0;
+                            spawner->bossWarningActive = false;
+                            spawner->bossWarningTimer = 0.0f;
+                            std::cout << "Advancing to Level " << spawner->currentLevel + 1 << std::endl;
                         }
-                    } else if (enemyTag.name == "Boss_2") {
+                    } else if (enemyTag.id == tags::Boss2) {
                         is_boss = true;
                         auto world_entity = registry.createEntity();
                         registry.addComponent<component::StageCleared>(world_entity, 2);
@@ -258,7 +528,7 @@ void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine
                             for (auto entity : view) {
                                 auto& tag = view.get<component::Tag>(entity);
                                 auto& parent = view.get<component::Parent>(entity);
-                                if (tag.name == "ForcePod" && parent.ownerId == scorer_id) {
+                                if (tag.id == tags::ForcePod && parent.ownerId == scorer_id) {
                                     podCount++;
                                 }
                             }
@@ -376,6 +646,7 @@ void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine
                 else
                     posP.y += overlapY;
             }
+            registry.markChanged<component::Position>(player_entity);
         }
     }
 
@@ -393,7 +664,7 @@ void CollisionSystem::HandleCollision(GameEngine::Registry& registry, GameEngine
         bool is_charged = false;
         if (registry.hasComponent<component::Tag>(player_projectile)) {
             const auto& tag = registry.getComponent<component::Tag>(player_projectile);
-            if (tag.name.find("charge") != std::string::npos) {
+            if (tags::isChargeShot(tag.id)) {
                 is_charged = true;
             }
         }
@@ -456,7 +727,7 @@ void spawnForcePodItem(GameEngine::Registry& registry, float x, float y) {
     registry.addComponent<component::PowerUpType>(item, component::PowerUpTypeEnum::FORCE_POD);
     registry.addComponent<component::Collidable>(item, component::CollisionLayer::PowerUp);
     registry.addComponent<component::HitBox>(item, 64.0f, 64.0f);
-    registry.addComponent<component::Tag>(item, "ForcePodItem");
+    registry.addComponent<component::Tag>(item, tags::ForcePodItem);
     registry.addComponent<component::SpawnEffect>(item);
 }
 
@@ -468,7 +739,7 @@ void spawnForcePodCompanion(GameEngine::Registry& registry, GameEngine::entity_t
     for (auto entity : view) {
         auto& tag = view.get<component::Tag>(entity);
         auto& parent = view.get<component::Parent>(entity);
-        if (tag.name == "ForcePod" && parent.ownerId == static_cast<size_t>(playerId)) {
+        if (tag.id == tags::ForcePod && parent.ownerId == static_cast<size_t>(playerId)) {
             podCount++;
         }
     }
@@ -487,7 +758,7 @@ void spawnForcePodCompanion(GameEngine::Registry& registry, GameEngine::entity_t
     drawable.current_sprite = 0;
     drawable.sprite_index = 0;
 
-    if (drawable.texture_name.empty()) {
+    if (drawable.texture_name().empty()) {
         std::cerr << "[WARNING] Force Pod spawned with invalid Sprite ID/Name!" << std::endl;
     }
 
@@ -496,8 +767,7 @@ void spawnForcePodCompanion(GameEngine::Registry& registry, GameEngine::entity_t
         podFrames.push_back("force_pod_" + std::to_string(i));
     registry.addComponent<component::TextureAnimation>(pod, podFrames, 0.04f, true);
     auto& weapon = registry.addComponent<component::Weapon>(pod);
-    std::string pTag = (podCount == 0) ? "PodProjectile" : "PodProjectileRed";
-    weapon.projectileTag = pTag;
+    weapon.projectileTag = (podCount == 0) ? tags::PodProjectile : tags::PodProjectileRed;
     weapon.fireRate = 0.3f;
     weapon.projectileSpeed = 1000.0f;
     weapon.damage = 15.0f;
@@ -505,14 +775,14 @@ void spawnForcePodCompanion(GameEngine::Registry& registry, GameEngine::entity_t
     weapon.spawnOffsetY = 0.0f;
     registry.addComponent<component::Collidable>(pod, component::CollisionLayer::Companion);
     registry.addComponent<component::HitBox>(pod, 64.0f, 64.0f);
-    registry.addComponent<component::Tag>(pod, "ForcePod");
+    registry.addComponent<component::Tag>(pod, tags::ForcePod);
 
     if (podCount == 1) {
         auto itemView = registry.view<component::Tag>();
         std::vector<GameEngine::entity_t> itemsToRemove;
         for (auto entity : itemView) {
             const auto& tag = itemView.get<component::Tag>(entity);
-            if (tag.name == "ForcePodItem") {
+            if (tag.id == tags::ForcePodItem) {
                 itemsToRemove.push_back(entity);
             }
         }
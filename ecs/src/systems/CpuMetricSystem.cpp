@@ -9,7 +9,7 @@ namespace rtype::ecs {
 
 void CpuMetricSystem::update(GameEngine::Registry& registry, double dt) {
     (void)dt;
-    auto view = registry.view<component::CpuStats, component::TextDrawable, component::UITag>();
+    auto view = registry.query<component::CpuStats, component::TextDrawable, component::UITag>();
 
     for (auto entity : view) {
         auto& cpuStats = registry.getComponent<component::CpuStats>(entity);
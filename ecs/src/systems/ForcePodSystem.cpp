@@ -3,6 +3,7 @@
 #include "components/Position.hpp"
 #include "components/Weapon.hpp"
 #include "components/Tag.hpp"
+#include "SystemAccess.hpp"
 
 namespace rtype::ecs {
 
@@ -13,10 +14,8 @@ void ForcePodSystem::update(GameEngine::Registry& registry, double dt) {
 
     podView.each([&registry](auto entity, component::Parent& parent, component::Position& pos,
                              component::Weapon& weapon, component::Tag& tag) {
-        (void)entity;
-
         // Only process ForcePod entities
-        if (tag.name != "ForcePod") {
+        if (tag.id != tags::ForcePod) {
             return;
         }
 
@@ -26,6 +25,7 @@ void ForcePodSystem::update(GameEngine::Registry& registry, double dt) {
             auto& ownerPos = registry.getComponent<component::Position>(ownerId);
             pos.x = ownerPos.x + parent.offsetX;
             pos.y = ownerPos.y + parent.offsetY;
+            registry.markChanged<component::Position>(entity);
         }
 
         // 2. Sync shooting with owner
@@ -36,4 +36,8 @@ void ForcePodSystem::update(GameEngine::Registry& registry, double dt) {
     });
 }
 
+void ForcePodSystem::declareAccess(SystemAccess& access) const {
+    access.reads<component::Parent, component::Tag>().writes<component::Position, component::Weapon>();
+}
+
 } // namespace rtype::ecs
@@ -8,7 +8,7 @@
 namespace rtype::ecs {
 
 void FpsSystem::update(GameEngine::Registry& registry, double dt) {
-    auto view = registry.view<component::FpsCounter, component::TextDrawable, component::UITag>();
+    auto view = registry.query<component::FpsCounter, component::TextDrawable, component::UITag>();
 
     for (auto entity : view) {
         auto& fps_counter = registry.getComponent<component::FpsCounter>(static_cast<GameEngine::entity_t>(entity));
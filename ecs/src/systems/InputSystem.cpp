@@ -25,7 +25,7 @@ void InputSystem::update(GameEngine::Registry& registry, double /* dt */) {
         bool is_player = false;
         if (registry.hasComponent<component::Tag>(static_cast<size_t>(entity))) {
             auto& tag = registry.getComponent<component::Tag>(static_cast<size_t>(entity));
-            if (tag.name == "Player") {
+            if (tag.id == tags::Player) {
                 is_player = true;
             }
         }
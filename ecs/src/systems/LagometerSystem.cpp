@@ -9,8 +9,8 @@
 namespace rtype::ecs {
 
 void LagometerSystem::update(GameEngine::Registry& registry, double dt, sf::RenderWindow& window) {
-    auto lagometer_view = registry.view<component::LagometerComponent, component::Position, component::UITag>();
-    auto ping_view = registry.view<component::PingStats>();
+    auto lagometer_view = registry.query<component::LagometerComponent, component::Position, component::UITag>();
+    auto ping_view = registry.query<component::PingStats>();
 
     for (auto lag_entity : lagometer_view) {
         auto& lagometer = registry.getComponent<component::LagometerComponent>(lag_entity);
@@ -34,7 +34,7 @@ void LagometerSystem::update(GameEngine::Registry& registry, double dt, sf::Rend
 }
 
 void LagometerSystem::render_lagometer(GameEngine::Registry& registry, sf::RenderWindow& window) {
-    auto view = registry.view<component::LagometerComponent, component::Position>();
+    auto view = registry.query<component::LagometerComponent, component::Position>();
 
     for (auto entity : view) {
         auto& lagometer = registry.getComponent<component::LagometerComponent>(entity);
@@ -14,7 +14,7 @@
 namespace rtype::ecs {
 
 void LivesSystem::update(GameEngine::Registry& registry, double dt) {
-    auto view = registry.view<component::Health, component::Lives, component::Position>();
+    auto view = registry.query<component::Health, component::Lives, component::Position>();
     std::vector<GameEngine::entity_t> to_destroy;
 
     for (auto entity : view) {
@@ -30,7 +30,7 @@ void LivesSystem::update(GameEngine::Registry& registry, double dt) {
                 health.hp = health.max_hp;
 
                 if (registry.hasComponent<component::Velocity>(static_cast<std::size_t>(entity))) {
-                    auto& velocity = registry.getComponent<component::Velocity>(static_cast<std::size_t>(entity));
+                    auto& velocity = registry.patch<component::Velocity>(static_cast<std::size_t>(entity));
                     velocity.vx = 0.0f;
                     velocity.vy = 0.0f;
                 }
@@ -30,7 +30,7 @@ void MapGeneratorSystem::update(GameEngine::Registry& registry, float view_cente
         registry.addComponent<component::HitBox>(platform, 100.0f, 20.0f);
         registry.addComponent<component::Collidable>(platform, component::CollisionLayer::Obstacle);
         registry.addComponent<component::Drawable>(platform, "green_platform", 0, 0, 100, 20);
-        registry.addComponent<component::Tag>(platform, "Platform");
+        registry.addComponent<component::Tag>(platform, tags::Platform);
 
         if (std::rand() % 100 < 10) {
             float hole_x;
@@ -57,7 +57,7 @@ void MapGeneratorSystem::update(GameEngine::Registry& registry, float view_cente
                 registry.addComponent<component::Position>(hole, hole_x, new_y - 50.0f);
                 registry.addComponent<component::HitBox>(hole, 60.0f, 60.0f);
                 registry.addComponent<component::Drawable>(hole, "hole", 0, 0, 0, 0);
-                registry.addComponent<component::Tag>(hole, "Hole");
+                registry.addComponent<component::Tag>(hole, tags::Hole);
             }
         } else if (std::rand() % 100 < 10) {
             float monster_x = new_x + 20.0f + static_cast<float>(std::rand() % 60);
@@ -66,7 +66,7 @@ void MapGeneratorSystem::update(GameEngine::Registry& registry, float view_cente
             registry.addComponent<component::Position>(monster, monster_x, new_y - 50.0f);
             registry.addComponent<component::HitBox>(monster, 50.0f, 50.0f);
             registry.addComponent<component::Drawable>(monster, "monster", 0, 0, 0, 0, 0.15f, 0.15f);
-            registry.addComponent<component::Tag>(monster, "Monster");
+            registry.addComponent<component::Tag>(monster, tags::Monster);
             registry.addComponent<component::Collidable>(monster, component::CollisionLayer::Enemy);
         }
 
@@ -5,7 +5,8 @@
 #include "components/Tag.hpp"
 #include "components/Projectile.hpp"
 #include "utils/GameConfig.hpp"
-#include <vector>
+#include "CommandBuffer.hpp"
+#include "SystemAccess.hpp"
 
 namespace rtype::ecs {
 
@@ -13,35 +14,30 @@ void MobSystem::update(GameEngine::Registry& registry, double dt) {
     (void)dt;
     auto view = registry.view<component::ScreenMode, component::Position, component::Velocity, component::Tag>();
 
-    std::vector<GameEngine::entity_t> mobs_to_switch;
+    auto& commands = registry.commands();
 
-    view.each([&](auto entity, component::ScreenMode&, component::Position& pos, component::Velocity& vel,
-                  component::Tag& tag) {
+    view.each([&](auto entity, component::Position& pos, component::Velocity& vel, component::Tag& tag) {
         bool switch_mode = false;
-        if (tag.name == "Monster_0_Top") {
+        if (tag.id == tags::Monster0Top) {
             if (pos.y > rtype::config::MAP_MAX_Y) {
                 switch_mode = true;
             }
-        } else if (tag.name == "Monster_0_Bot") {
+        } else if (tag.id == tags::Monster0Bot) {
             if (pos.y < rtype::config::MAP_MIN_Y) {
                 switch_mode = true;
             }
         }
 
         if (switch_mode) {
-            mobs_to_switch.push_back(static_cast<GameEngine::entity_t>(entity));
+            commands.remove<component::ScreenMode>(entity);
             vel.vx -= rtype::config::SCROLL_SPEED;
+            registry.markChanged<component::Velocity>(entity);
         }
     });
 
-    for (auto entity : mobs_to_switch) {
-        registry.removeComponent<component::ScreenMode>(entity);
-    }
-
     auto proj_view = registry.view<component::ScreenMode, component::Projectile, component::Velocity>();
-    std::vector<GameEngine::entity_t> projs_to_switch;
 
-    proj_view.each([&](auto entity, component::ScreenMode&, component::Projectile& proj, component::Velocity& vel) {
+    proj_view.each([&](auto entity, component::Projectile& proj, component::Velocity& vel) {
         bool owner_active = false;
         if (registry.isValid(static_cast<GameEngine::entity_t>(proj.owner_id))) {
             if (registry.hasComponent<component::ScreenMode>(static_cast<std::size_t>(proj.owner_id))) {
@@ -50,14 +46,16 @@ void MobSystem::update(GameEngine::Registry& registry, double dt) {
         }
 
         if (!owner_active) {
-            projs_to_switch.push_back(static_cast<GameEngine::entity_t>(entity));
+            commands.remove<component::ScreenMode>(entity);
             vel.vx -= rtype::config::SCROLL_SPEED;
+            registry.markChanged<component::Velocity>(entity);
         }
     });
+}
 
-    for (auto entity : projs_to_switch) {
-        registry.removeComponent<component::ScreenMode>(entity);
-    }
+void MobSystem::declareAccess(SystemAccess& access) const {
+    access.reads<component::Position, component::Tag, component::Projectile>()
+        .writes<component::ScreenMode, component::Velocity>();
 }
 
 } // namespace rtype::ecs
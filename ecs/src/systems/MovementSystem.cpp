@@ -2,36 +2,43 @@
 #include "components/Position.hpp"
 #include "components/Velocity.hpp"
 #include "components/MovementPattern.hpp"
+#include "SystemAccess.hpp"
 #include <cmath>
 
 namespace rtype::ecs {
 
 void MovementSystem::update(GameEngine::Registry& registry, double dt) {
     auto patternView = registry.view<component::MovementPattern, component::Velocity>();
-    patternView.each([dt]([[maybe_unused]] auto entity, component::MovementPattern& pattern, component::Velocity& vel) {
+    patternView.each([&registry, dt](auto entity, component::MovementPattern& pattern, component::Velocity& vel) {
         pattern.timer += static_cast<float>(dt);
 
         if (pattern.type == component::MovementPatternType::Circular) {
             float angle = pattern.timer * pattern.frequency;
             vel.vx = -std::sin(angle) * pattern.amplitude * pattern.frequency - 400.0f;
             vel.vy = std::cos(angle) * pattern.amplitude * pattern.frequency;
+            registry.markChanged<component::Velocity>(entity);
         } else if (pattern.type == component::MovementPatternType::Sinusoidal) {
             float angle = pattern.timer * pattern.frequency;
             vel.vy = std::cos(angle) * pattern.amplitude;
+            registry.markChanged<component::Velocity>(entity);
         } else if (pattern.type == component::MovementPatternType::RandomVertical) {
             if (pattern.timer >= pattern.frequency) {
                 pattern.timer = 0;
                 int dir = rand() % 3 - 1;
                 vel.vy = dir * pattern.amplitude;
+                registry.markChanged<component::Velocity>(entity);
             }
         }
     });
 
-    auto view = registry.view<component::Position, component::Velocity>();
+    auto movers = registry.group<component::Position, component::Velocity>();
 
-    view.each([&registry, dt](auto entity, component::Position& pos, component::Velocity& vel) {
-        pos.x += vel.vx * static_cast<float>(dt);
-        pos.y += vel.vy * static_cast<float>(dt);
+    movers.each_parallel([&registry, dt](auto entity, component::Position& pos, component::Velocity& vel) {
+        if (vel.vx != 0.0f || vel.vy != 0.0f) {
+            pos.x += vel.vx * static_cast<float>(dt);
+            pos.y += vel.vy * static_cast<float>(dt);
+            registry.markChanged<component::Position>(entity);
+        }
 
         if (registry.hasComponent<component::MovementPattern>(entity)) {
             auto& pattern = registry.getComponent<component::MovementPattern>(entity);
@@ -39,13 +46,19 @@ void MovementSystem::update(GameEngine::Registry& registry, double dt) {
                 if (pos.y < 50.0f && vel.vy < 0) {
                     vel.vy = -vel.vy;
                     pos.y = 50.0f;
+                    registry.markChanged<component::Velocity>(entity);
                 } else if (pos.y > 750.0f && vel.vy > 0) {
                     vel.vy = -vel.vy;
                     pos.y = 750.0f;
+                    registry.markChanged<component::Velocity>(entity);
                 }
             }
         }
     });
 }
 
+void MovementSystem::declareAccess(SystemAccess& access) const {
+    access.writes<component::MovementPattern, component::Velocity, component::Position>();
+}
+
 } // namespace rtype::ecs
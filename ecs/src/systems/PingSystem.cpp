@@ -10,7 +10,7 @@ namespace rtype::ecs {
 
 // Update method now depends only on Registry and time
 void PingSystem::update(GameEngine::Registry& registry, double dt) {
-    auto view = registry.view<component::PingStats, component::TextDrawable, component::UITag>();
+    auto view = registry.query<component::PingStats, component::TextDrawable, component::UITag>();
 
     for (auto entity : view) {
         auto& pingStats = registry.getComponent<component::PingStats>(entity);
@@ -1,24 +1,24 @@
 #include "systems/ProjectileSystem.hpp"
 #include "components/Projectile.hpp"
-#include <vector>
+#include "CommandBuffer.hpp"
+#include "SystemAccess.hpp"
 
 namespace rtype::ecs {
 
 void ProjectileSystem::update(GameEngine::Registry& registry, double dt) {
     auto view = registry.view<component::Projectile>();
-    std::vector<GameEngine::entity_t> to_destroy;
 
-    view.each([&](auto entity, component::Projectile& projectile) {
+    view.each_parallel([&registry, dt](auto entity, component::Projectile& projectile) {
         projectile.lifetime -= dt;
 
         if (projectile.lifetime <= 0.0f) {
-            to_destroy.push_back(static_cast<GameEngine::entity_t>(entity));
+            registry.commands().destroy(entity);
         }
     });
+}
 
-    for (auto entity : to_destroy) {
-        registry.destroyEntity(entity);
-    }
+void ProjectileSystem::declareAccess(SystemAccess& access) const {
+    access.writes<component::Projectile>();
 }
 
 } // namespace rtype::ecs
@@ -9,8 +9,8 @@
 #include "components/Controllable.hpp"
 #include "AccessibilityManager.hpp"
 #include "net/MessageData.hpp"
+#include "CommandBuffer.hpp"
 #include <algorithm>
-#include <vector>
 #include <iostream>
 
 namespace rtype::ecs {
@@ -25,27 +25,28 @@ void RenderSystem::update(GameEngine::Registry& registry, double dt) {
         return;
     }
 
-    auto view = registry.view<component::Position, component::Drawable>();
-    std::vector<GameEngine::entity_t> explosions_to_destroy;
+    auto view = registry.query<component::Position, component::Drawable>();
+    auto& commands = registry.commands();
 
     for (auto entity : view) {
         GameEngine::entity_t entity_id = static_cast<GameEngine::entity_t>(entity);
         auto& pos = registry.getComponent<component::Position>(static_cast<size_t>(entity));
         auto& drawable = registry.getComponent<component::Drawable>(static_cast<size_t>(entity));
+        const std::string& texture_name = drawable.texture_name();
 
         uint32_t texture_width = 0, texture_height = 0;
-        if (!renderer_->get_texture_size(drawable.texture_name, texture_width, texture_height)) {
+        if (!renderer_->get_texture_size(texture_name, texture_width, texture_height)) {
             continue;
         }
 
         bool is_explosion = registry.hasComponent<component::Explosion>(entity_id);
 
-        if (!drawable.current_state.empty() && drawable.animation_sequences.count(drawable.current_state)) {
-            const auto& sequence = drawable.animation_sequences.at(drawable.current_state);
+        if (drawable.clip != clips::None) {
+            const auto& sequence = AnimationClips::get(drawable.clip).frames;
             if (!sequence.empty()) {
-                if (drawable.last_state != drawable.current_state) {
+                if (drawable.last_clip != drawable.clip) {
                     drawable.animation_index = 0;
-                    drawable.last_state = drawable.current_state;
+                    drawable.last_clip = drawable.clip;
                     drawable.current_sprite = sequence[drawable.animation_index];
                     drawable.animation_timer = 0.0f;
                 } else {
@@ -67,7 +68,7 @@ void RenderSystem::update(GameEngine::Registry& registry, double dt) {
                 if (is_explosion && !drawable.loop &&
                     drawable.animation_index >= static_cast<uint32_t>(sequence.size() - 1) &&
                     drawable.animation_timer >= drawable.animation_speed * 0.9f) {
-                    explosions_to_destroy.push_back(entity_id);
+                    commands.destroy(entity_id);
                     continue;
                 }
             }
@@ -89,7 +90,7 @@ void RenderSystem::update(GameEngine::Registry& registry, double dt) {
             if (is_explosion && !drawable.loop &&
                 drawable.current_sprite >= static_cast<uint32_t>(drawable.frame_count - 1) &&
                 drawable.animation_timer >= drawable.animation_speed * 0.9f) {
-                explosions_to_destroy.push_back(entity_id);
+                commands.destroy(entity_id);
                 continue;
             }
         }
@@ -99,7 +100,7 @@ void RenderSystem::update(GameEngine::Registry& registry, double dt) {
         render_data.y = pos.y;
         render_data.scale_x = drawable.scale_x;
         render_data.scale_y = drawable.scale_y;
-        render_data.texture_name = drawable.texture_name;
+        render_data.texture_name = texture_name;
         render_data.current_sprite = drawable.current_sprite;
         render_data.frame_count = drawable.frame_count;
         render_data.sprite_index = drawable.sprite_index;
@@ -115,11 +116,10 @@ void RenderSystem::update(GameEngine::Registry& registry, double dt) {
 
             if (registry.hasComponent<component::NetworkId>(entity_id)) {
                 entity_type = rtype::net::EntityType::PLAYER;
-            } else if (drawable.texture_name.find("player") != std::string::npos ||
-                       drawable.texture_name == "player_ships") {
+            } else if (texture_name.find("player") != std::string::npos || texture_name == "player_ships") {
                 entity_type = rtype::net::EntityType::PLAYER;
-            } else if (drawable.texture_name.find("enemy") != std::string::npos ||
-                       drawable.texture_name.find("monster") != std::string::npos) {
+            } else if (texture_name.find("enemy") != std::string::npos ||
+                       texture_name.find("monster") != std::string::npos) {
                 entity_type = rtype::net::EntityType::ENEMY;
             }
 
@@ -152,10 +152,7 @@ void RenderSystem::update(GameEngine::Registry& registry, double dt) {
 
         renderer_->draw_sprite(render_data);
     }
-
-    for (auto explosion_entity : explosions_to_destroy) {
-        registry.destroyEntity(explosion_entity);
-    }
+    renderer_->flush();
 }
 
 void RenderSystem::set_renderer(std::shared_ptr<rtype::rendering::IRenderer> renderer) {
@@ -1,13 +1,15 @@
 #include "systems/ScoreSystem.hpp"
 #include "components/Score.hpp"
 #include "utils/Logger.hpp"
+#include "CommandBuffer.hpp"
+#include "SystemAccess.hpp"
 
 namespace rtype::ecs {
 
 void ScoreSystem::update(GameEngine::Registry& registry, double dt) {
     (void)dt;
     auto view = registry.view<component::Score, component::ScoreEvent>();
-    std::vector<GameEngine::entity_t> to_remove_event;
+    auto& commands = registry.commands();
 
     for (auto entity : view) {
         auto& score = view.get<component::Score>(entity);
@@ -21,12 +23,12 @@ void ScoreSystem::update(GameEngine::Registry& registry, double dt) {
         Logger::instance().info("Score updated for entity " + std::to_string(static_cast<std::size_t>(entity)) + ": " +
                                 std::to_string(score.value) + " (+" + std::to_string(event.points) + ")");
 
-        to_remove_event.push_back(static_cast<GameEngine::entity_t>(entity));
+        commands.remove<component::ScoreEvent>(entity);
     }
+}
 
-    for (auto entity : to_remove_event) {
-        registry.removeComponent<component::ScoreEvent>(entity);
-    }
+void ScoreSystem::declareAccess(SystemAccess& access) const {
+    access.writes<component::Score, component::ScoreEvent>();
 }
 
 } // namespace rtype::ecs
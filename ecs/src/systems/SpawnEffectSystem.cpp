@@ -1,14 +1,14 @@
 #include "systems/SpawnEffectSystem.hpp"
 #include "components/SpawnEffect.hpp"
 #include "components/Drawable.hpp"
-#include <vector>
+#include "CommandBuffer.hpp"
+#include "SystemAccess.hpp"
 
 namespace rtype::ecs {
 
 void SpawnEffectSystem::update(GameEngine::Registry& registry, double dt) {
     auto view = registry.view<component::SpawnEffect, component::Drawable>();
-
-    std::vector<GameEngine::entity_t> toRemove;
+    auto& commands = registry.commands();
 
     view.each([&](auto entity, component::SpawnEffect& effect, component::Drawable& drawable) {
         effect.elapsed += static_cast<float>(dt);
@@ -23,13 +23,13 @@ void SpawnEffectSystem::update(GameEngine::Registry& registry, double dt) {
         drawable.scale_y = currentScale;
 
         if (effect.elapsed >= effect.duration) {
-            toRemove.push_back(static_cast<GameEngine::entity_t>(entity));
+            commands.remove<component::SpawnEffect>(entity);
         }
     });
+}
 
-    for (auto entity : toRemove) {
-        registry.removeComponent<component::SpawnEffect>(entity);
-    }
+void SpawnEffectSystem::declareAccess(SystemAccess& access) const {
+    access.writes<component::SpawnEffect, component::Drawable>();
 }
 
 } // namespace rtype::ecs
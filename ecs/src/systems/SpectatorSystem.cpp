@@ -33,7 +33,7 @@ void SpectatorSystem::update(GameEngine::Registry& registry, double dt) {
             std::size_t player_id = static_cast<std::size_t>(player_entity);
             auto& tag = registry.getComponent<component::Tag>(player_id);
 
-            if (tag.name == "Player") {
+            if (tag.id == tags::Player) {
                 valid_targets.push_back(player_id);
             }
         }
@@ -0,0 +1,46 @@
+#include "systems/SystemTimingSystem.hpp"
+#include "components/SystemTimings.hpp"
+#include "components/TextDrawable.hpp"
+#include "components/UITag.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace rtype::ecs {
+
+namespace {
+
+constexpr float REFRESH_INTERVAL = 0.5f;
+
+} // namespace
+
+void SystemTimingSystem::update(GameEngine::Registry& registry, double dt) {
+    auto view = registry.view<component::SystemTimings, component::TextDrawable, component::UITag>();
+
+    view.each([this, dt](auto, component::SystemTimings& timings, component::TextDrawable& textDrawable) {
+        timings.refreshTimer -= static_cast<float>(dt);
+        if (timings.refreshTimer > 0.0f) {
+            return;
+        }
+        timings.refreshTimer = REFRESH_INTERVAL;
+
+        auto stats = _systemManager.timings();
+        if (stats.empty()) {
+            textDrawable.text.setString("SYSTEMS: profiling off");
+            return;
+        }
+        std::sort(stats.begin(), stats.end(), [](const auto& lhs, const auto& rhs) { return lhs.p95Ms > rhs.p95Ms; });
+
+        std::stringstream ss;
+        ss << "SYSTEMS p50/p95/p99/max ms";
+        const std::size_t lines = std::min<std::size_t>(stats.size(), timings.maxLines);
+        for (std::size_t i = 0; i < lines; ++i) {
+            const auto& entry = stats[i];
+            ss << "\n" << entry.name << " " << std::fixed << std::setprecision(2) << entry.p50Ms << "/" << entry.p95Ms
+               << "/" << entry.p99Ms << "/" << entry.maxMs << " (" << entry.entities << ")";
+        }
+        textDrawable.text.setString(ss.str());
+    });
+}
+
+} // namespace rtype::ecs
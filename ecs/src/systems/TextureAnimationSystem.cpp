@@ -12,7 +12,7 @@ void TextureAnimationSystem::update(GameEngine::Registry& registry, double dt) {
         auto& drawable = view.get<component::Drawable>(entity);
         auto& animation = view.get<component::TextureAnimation>(entity);
 
-        if (animation.frameTextureNames.empty()) {
+        if (animation.frameTextures.empty()) {
             continue;
         }
 
@@ -22,17 +22,17 @@ void TextureAnimationSystem::update(GameEngine::Registry& registry, double dt) {
             animation.elapsedTime = 0.0f;
             animation.currentFrameIndex++;
 
-            if (animation.currentFrameIndex >= static_cast<int>(animation.frameTextureNames.size())) {
+            if (animation.currentFrameIndex >= static_cast<int>(animation.frameTextures.size())) {
                 if (animation.loop) {
                     animation.currentFrameIndex = 0;
                 } else {
-                    animation.currentFrameIndex = static_cast<int>(animation.frameTextureNames.size()) - 1;
+                    animation.currentFrameIndex = static_cast<int>(animation.frameTextures.size()) - 1;
                 }
             }
 
             if (animation.currentFrameIndex >= 0 &&
-                animation.currentFrameIndex < static_cast<int>(animation.frameTextureNames.size())) {
-                drawable.texture_name = animation.frameTextureNames[animation.currentFrameIndex];
+                animation.currentFrameIndex < static_cast<int>(animation.frameTextures.size())) {
+                drawable.texture = animation.frameTextures[animation.currentFrameIndex];
 
                 drawable.current_sprite = 0;
                 drawable.frame_count = 1;
@@ -23,7 +23,7 @@ void UIRenderSystem::update(GameEngine::Registry& registry, double dt) {
     // Set default view for UI rendering (screen-space)
     window_->setView(window_->getDefaultView());
 
-    auto view = registry.view<component::UITag, component::TextDrawable>();
+    auto view = registry.query<component::UITag, component::TextDrawable>();
 
     for (auto entity : view) {
         auto& text_drawable = registry.getComponent<component::TextDrawable>(static_cast<GameEngine::entity_t>(entity));
@@ -40,7 +40,7 @@ void UIRenderSystem::update(GameEngine::Registry& registry, double dt) {
     }
 
     // Display "SPECTATOR MODE" if local player is spectating
-    auto spectator_check_view = registry.view<component::Controllable, component::SpectatorComponent>();
+    auto spectator_check_view = registry.query<component::Controllable, component::SpectatorComponent>();
     for (auto entity : spectator_check_view) {
         auto& ctrl = registry.getComponent<component::Controllable>(static_cast<GameEngine::entity_t>(entity));
 
@@ -10,21 +10,21 @@
 #include "components/ScreenMode.hpp"
 #include "components/AudioEvent.hpp"
 #include "utils/GameConfig.hpp"
-#include <vector>
+#include "CommandBuffer.hpp"
 #include <cmath>
 #include "utils/Logger.hpp"
 
 namespace rtype::ecs {
 
 void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
-    auto view = registry.view<component::Weapon, component::Position>();
+    auto view = registry.query<component::Weapon, component::Position>();
 
     struct ProjectileRequest {
         float x, y;
         float vx, vy;
         float damage;
         float lifetime;
-        std::string tag;
+        TagId tag;
         float w, h;
         component::CollisionLayer layer;
         std::size_t ownerId;
@@ -33,7 +33,34 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
         float patternFrequency;
     };
 
-    std::vector<ProjectileRequest> requests;
+    auto& commands = registry.commands();
+    auto queueProjectile = [&commands](const ProjectileRequest& req) {
+        auto projectile = commands.create();
+        commands.add<component::Position>(projectile, req.x, req.y);
+        commands.add<component::Velocity>(projectile, req.vx, req.vy);
+        commands.add<component::Projectile>(projectile, req.damage, req.lifetime, req.ownerId);
+        commands.add<component::HitBox>(projectile, req.w, req.h);
+        commands.add<component::Tag>(projectile, req.tag);
+        commands.add<component::Collidable>(projectile, req.layer);
+        if (req.patternType != component::MovementPatternType::None) {
+            commands.add<component::MovementPattern>(projectile, req.patternType, 0.0f, req.patternAmplitude,
+                                                     req.patternFrequency);
+        }
+
+        // Add audio event for shooting
+        bool is_player = (req.layer == component::CollisionLayer::PlayerProjectile || tags::isPlayerShot(req.tag));
+        if (is_player) {
+            // Use missile sound for charged shots, regular shoot sound for normal shots
+            bool is_missile = tags::isChargeShot(req.tag);
+            if (is_missile) {
+                commands.add<component::AudioEvent>(projectile, component::AudioEventType::PLAYER_MISSILE);
+            } else {
+                commands.add<component::AudioEvent>(projectile, component::AudioEventType::PLAYER_SHOOT);
+            }
+        } else {
+            commands.add<component::AudioEvent>(projectile, component::AudioEventType::ENEMY_SHOOT);
+        }
+    };
 
     view.each([&](auto entity, component::Weapon& weapon, component::Position& pos) {
         weapon.timeSinceLastFire += static_cast<float>(dt);
@@ -44,7 +71,7 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
         if (registry.hasComponent<component::Tag>(static_cast<std::size_t>(entity))) {
             const auto& tag = registry.getComponent<component::Tag>(static_cast<std::size_t>(entity));
 
-            if (tag.name == "Boss_2") {
+            if (tag.id == tags::Boss2) {
                 if (weapon.timeSinceLastFire >= 0.1f) {
                     float spawnX = pos.x + weapon.spawnOffsetX;
                     float spawnY = pos.y + weapon.spawnOffsetY;
@@ -54,9 +81,9 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
                     float vx = std::cos(rad) * 400.0f;
                     float vy = std::sin(rad) * 400.0f;
 
-                    requests.push_back({spawnX, spawnY, vx, vy, 10.0f, 5.0f, "Boss_2_Projectile", 60.0f, 60.0f,
-                                        component::CollisionLayer::EnemyProjectile, static_cast<std::size_t>(entity),
-                                        component::MovementPatternType::None, 0.0f, 0.0f});
+                    queueProjectile({spawnX, spawnY, vx, vy, 10.0f, 5.0f, tags::Boss2Projectile, 60.0f, 60.0f,
+                                      component::CollisionLayer::EnemyProjectile, static_cast<std::size_t>(entity),
+                                      component::MovementPatternType::None, 0.0f, 0.0f});
 
                     weapon.projectileAmplitude += 15.0f;
                     if (weapon.projectileAmplitude >= 360.0f)
@@ -65,16 +92,16 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
                     int shotCount = static_cast<int>(weapon.projectileFrequency);
                     if (shotCount >= 20) {
                         float spreadSpeed = 500.0f;
-                        requests.push_back({spawnX, spawnY, -spreadSpeed, 0.0f, 30.0f, 5.0f, "Boss_2_Projectile_2",
-                                            160.0f, 160.0f, component::CollisionLayer::EnemyProjectile,
-                                            static_cast<std::size_t>(entity), component::MovementPatternType::None,
-                                            0.0f, 0.0f});
-                        requests.push_back(
-                            {spawnX, spawnY, -spreadSpeed * 0.9f, -150.0f, 30.0f, 5.0f, "Boss_2_Projectile_2", 160.0f,
+                        queueProjectile({spawnX, spawnY, -spreadSpeed, 0.0f, 30.0f, 5.0f, tags::Boss2Projectile2,
+                                          160.0f, 160.0f, component::CollisionLayer::EnemyProjectile,
+                                          static_cast<std::size_t>(entity), component::MovementPatternType::None,
+                                          0.0f, 0.0f});
+                        queueProjectile(
+                            {spawnX, spawnY, -spreadSpeed * 0.9f, -150.0f, 30.0f, 5.0f, tags::Boss2Projectile2, 160.0f,
                              160.0f, component::CollisionLayer::EnemyProjectile, static_cast<std::size_t>(entity),
                              component::MovementPatternType::None, 0.0f, 0.0f});
-                        requests.push_back(
-                            {spawnX, spawnY, -spreadSpeed * 0.9f, 150.0f, 30.0f, 5.0f, "Boss_2_Projectile_2", 160.0f,
+                        queueProjectile(
+                            {spawnX, spawnY, -spreadSpeed * 0.9f, 150.0f, 30.0f, 5.0f, tags::Boss2Projectile2, 160.0f,
                              160.0f, component::CollisionLayer::EnemyProjectile, static_cast<std::size_t>(entity),
                              component::MovementPatternType::None, 0.0f, 0.0f});
                         shotCount = 0;
@@ -85,28 +112,28 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
                 return;
             }
 
-            if (tag.name == "Monster_Wave_2_Left" || tag.name == "Monster_Wave_2_Right") {
+            if (tag.id == tags::MonsterWave2Left || tag.id == tags::MonsterWave2Right) {
                 if (registry.hasComponent<component::Velocity>(static_cast<std::size_t>(entity))) {
                     const auto& vel = registry.getComponent<component::Velocity>(static_cast<std::size_t>(entity));
                     if (std::abs(vel.vy) < 20.0f && weapon.timeSinceLastFire >= 1.0f) {
                         float spawnX = pos.x + weapon.spawnOffsetX;
                         float spawnY = pos.y + weapon.spawnOffsetY;
-                        float baseVx = (tag.name == "Monster_Wave_2_Left") ? 400.0f : -400.0f;
+                        float baseVx = (tag.id == tags::MonsterWave2Left) ? 400.0f : -400.0f;
 
-                        requests.push_back({spawnX, spawnY, baseVx, 0.0f, 10.0f, 3.0f, "PodProjectileRed", 36.0f, 13.0f,
-                                            component::CollisionLayer::EnemyProjectile,
-                                            static_cast<std::size_t>(entity), component::MovementPatternType::None,
-                                            0.0f, 0.0f});
+                        queueProjectile({spawnX, spawnY, baseVx, 0.0f, 10.0f, 3.0f, tags::PodProjectileRed, 36.0f,
+                                         13.0f, component::CollisionLayer::EnemyProjectile,
+                                         static_cast<std::size_t>(entity), component::MovementPatternType::None,
+                                         0.0f, 0.0f});
 
-                        requests.push_back({spawnX, spawnY, baseVx * 0.9f, -150.0f, 10.0f, 3.0f, "PodProjectileRed",
-                                            36.0f, 13.0f, component::CollisionLayer::EnemyProjectile,
-                                            static_cast<std::size_t>(entity), component::MovementPatternType::None,
-                                            0.0f, 0.0f});
+                        queueProjectile({spawnX, spawnY, baseVx * 0.9f, -150.0f, 10.0f, 3.0f, tags::PodProjectileRed,
+                                          36.0f, 13.0f, component::CollisionLayer::EnemyProjectile,
+                                          static_cast<std::size_t>(entity), component::MovementPatternType::None,
+                                          0.0f, 0.0f});
 
-                        requests.push_back({spawnX, spawnY, baseVx * 0.9f, 150.0f, 10.0f, 3.0f, "PodProjectileRed",
-                                            36.0f, 13.0f, component::CollisionLayer::EnemyProjectile,
-                                            static_cast<std::size_t>(entity), component::MovementPatternType::None,
-                                            0.0f, 0.0f});
+                        queueProjectile({spawnX, spawnY, baseVx * 0.9f, 150.0f, 10.0f, 3.0f, tags::PodProjectileRed,
+                                          36.0f, 13.0f, component::CollisionLayer::EnemyProjectile,
+                                          static_cast<std::size_t>(entity), component::MovementPatternType::None,
+                                          0.0f, 0.0f});
 
                         weapon.timeSinceLastFire = 0.0f;
                     }
@@ -125,7 +152,7 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
             bool is_player = false;
             if (registry.hasComponent<component::Tag>(static_cast<std::size_t>(entity))) {
                 const auto& tag = registry.getComponent<component::Tag>(static_cast<std::size_t>(entity));
-                if (tag.name == "Player") {
+                if (tag.id == tags::Player) {
                     is_player = true;
                 }
             }
@@ -134,7 +161,7 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
                 vx -= rtype::config::SCROLL_SPEED;
             }
             float damage = weapon.damage;
-            std::string projectileTag = weapon.projectileTag;
+            TagId projectileTag = weapon.projectileTag;
             float hitBoxW = 0.0f;
             float hitBoxH = 0.0f;
 
@@ -151,34 +178,34 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
 
             if (registry.hasComponent<component::Tag>(static_cast<std::size_t>(entity))) {
                 const auto& tag = registry.getComponent<component::Tag>(static_cast<std::size_t>(entity));
-                if (tag.name == "Player") {
+                if (tag.id == tags::Player) {
                     switch (weapon.chargeLevel) {
                     case 0:
-                        projectileTag = "shot";
+                        projectileTag = tags::Shot;
                         hitBoxW = 87.0f;
                         hitBoxH = 99.0f;
                         damage = 10.0f;
                         break;
                     case 1:
-                        projectileTag = "shot_death-charge2";
+                        projectileTag = tags::ShotDeathCharge2;
                         hitBoxW = 80.0f;
                         hitBoxH = 80.0f;
                         damage = 20.0f;
                         break;
                     case 2:
-                        projectileTag = "shot_death-charge3";
+                        projectileTag = tags::ShotDeathCharge3;
                         hitBoxW = 100.0f;
                         hitBoxH = 100.0f;
                         damage = 30.0f;
                         break;
                     case 3:
-                        projectileTag = "shot_death-charge4";
+                        projectileTag = tags::ShotDeathCharge4;
                         hitBoxW = 120.0f;
                         hitBoxH = 120.0f;
                         damage = 40.0f;
                         break;
                     case 4:
-                        projectileTag = "Laser";
+                        projectileTag = tags::Laser;
                         hitBoxW = 100.0f;
                         hitBoxH = 20.0f;
                         damage = 50.0f;
@@ -188,7 +215,7 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
             }
 
             if (weapon.chargeLevel == 4) {
-                projectileTag = "Laser";
+                projectileTag = tags::Laser;
                 hitBoxW = 100.0f;
                 hitBoxH = 20.0f;
                 damage = 50.0f;
@@ -205,15 +232,15 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
             }
 
             float freq = weapon.projectileFrequency;
-            if (projectileTag == "Boss_1_Bayblade") {
+            if (projectileTag == tags::Boss1Bayblade) {
                 if (rand() % 2 == 0) {
                     freq = -freq;
                 }
             }
 
-            requests.push_back({spawnX, spawnY, vx, vy, damage, weapon.projectileLifetime, projectileTag, hitBoxW,
-                                hitBoxH, projLayer, static_cast<std::size_t>(entity), weapon.projectilePattern,
-                                weapon.projectileAmplitude, freq});
+            queueProjectile({spawnX, spawnY, vx, vy, damage, weapon.projectileLifetime, projectileTag, hitBoxW,
+                              hitBoxH, projLayer, static_cast<std::size_t>(entity), weapon.projectilePattern,
+                              weapon.projectileAmplitude, freq});
 
             weapon.timeSinceLastFire = 0.0f;
             if (!weapon.autoFire) {
@@ -221,36 +248,6 @@ void WeaponSystem::update(GameEngine::Registry& registry, double dt) {
             }
         }
     });
-
-    for (const auto& req : requests) {
-        auto projectile = registry.createEntity();
-        registry.addComponent<component::Position>(projectile, req.x, req.y);
-        registry.addComponent<component::Velocity>(projectile, req.vx, req.vy);
-        auto& projComp = registry.addComponent<component::Projectile>(projectile, req.damage, req.lifetime);
-        projComp.owner_id = req.ownerId;
-        registry.addComponent<component::HitBox>(projectile, req.w, req.h);
-        registry.addComponent<component::Tag>(projectile, req.tag);
-        registry.addComponent<component::Collidable>(projectile, req.layer);
-        if (req.patternType != component::MovementPatternType::None) {
-            registry.addComponent<component::MovementPattern>(projectile, req.patternType, 0.0f, req.patternAmplitude,
-                                                              req.patternFrequency);
-        }
-
-        // Add audio event for shooting
-        bool is_player =
-            (req.layer == component::CollisionLayer::PlayerProjectile || req.tag.find("shot") != std::string::npos);
-        if (is_player) {
-            // Use missile sound for charged shots, regular shoot sound for normal shots
-            bool is_missile = (req.tag.find("charge") != std::string::npos);
-            if (is_missile) {
-                registry.addComponent<component::AudioEvent>(projectile, component::AudioEventType::PLAYER_MISSILE);
-            } else {
-                registry.addComponent<component::AudioEvent>(projectile, component::AudioEventType::PLAYER_SHOOT);
-            }
-        } else {
-            registry.addComponent<component::AudioEvent>(projectile, component::AudioEventType::ENEMY_SHOOT);
-        }
-    }
 }
 
 } // namespace rtype::ecs
@@ -249,10 +249,10 @@ int main() {
             vel.vx = 0;
 
             static std::string last_horizontal_facing = "player_right";
-            if (registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name == "player_left") {
+            if (registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name() == "player_left") {
                 last_horizontal_facing = "player_left";
             }
-            if (registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name == "player_right") {
+            if (registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name() == "player_right") {
                 last_horizontal_facing = "player_right";
             }
 
@@ -260,21 +260,21 @@ int main() {
 
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
                 vel.vx = -400.0f;
-                registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name = "player_left";
+                registry.getComponent<rtype::ecs::component::Drawable>(player).set_texture("player_left");
                 last_horizontal_facing = "player_left";
                 moving_horizontal = true;
             }
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
                 vel.vx = 400.0f;
-                registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name = "player_right";
+                registry.getComponent<rtype::ecs::component::Drawable>(player).set_texture("player_right");
                 last_horizontal_facing = "player_right";
                 moving_horizontal = true;
             }
 
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-                registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name = "player_up";
+                registry.getComponent<rtype::ecs::component::Drawable>(player).set_texture("player_up");
             } else if (!moving_horizontal) {
-                registry.getComponent<rtype::ecs::component::Drawable>(player).texture_name = last_horizontal_facing;
+                registry.getComponent<rtype::ecs::component::Drawable>(player).set_texture(last_horizontal_facing);
             }
 
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
@@ -293,7 +293,7 @@ int main() {
 
                 if (dirX == 0.0f && dirY == 0.0f) {
                     auto& drawable = registry.getComponent<rtype::ecs::component::Drawable>(player);
-                    if (drawable.texture_name == "player_left") {
+                    if (drawable.texture_name() == "player_left") {
                         dirX = -1.0f;
                     } else {
                         dirX = 1.0f;
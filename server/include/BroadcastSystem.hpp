@@ -10,7 +10,6 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <unordered_set>
 
 namespace rtype::server {
 
@@ -18,6 +17,10 @@ class BroadcastSystem {
   public:
     BroadcastSystem(GameEngine::Registry& registry, UdpServer& udp_server,
                     rtype::net::IProtocolAdapter& protocol_adapter, rtype::net::IMessageSerializer& message_serializer);
+    ~BroadcastSystem();
+
+    BroadcastSystem(const BroadcastSystem&) = delete;
+    BroadcastSystem& operator=(const BroadcastSystem&) = delete;
 
     void update(double dt, const std::map<std::string, ClientInfo>& clients);
     void send_initial_state(const std::string& ip, uint16_t port);
@@ -37,8 +40,18 @@ class BroadcastSystem {
     rtype::net::IProtocolAdapter& protocol_adapter_;
     rtype::net::IMessageSerializer& message_serializer_;
 
-    std::unordered_set<uint32_t> last_known_entities_;
+    /// @brief Broadcasts between two full entity move refreshes, one second at the 60 Hz session tick
+    static constexpr uint32_t MOVE_KEYFRAME_INTERVAL = 60;
+
     uint32_t next_network_id_ = 10000;
+    uint32_t last_move_tick_ = 0;
+    uint32_t moves_since_keyframe_ = 0;
+    std::vector<GameEngine::entity_t> changed_entities_;
+
+    // Filled by registry signals between two updates
+    std::vector<GameEngine::entity_t> pending_spawns_;
+    std::vector<uint32_t> pending_deaths_;
+    std::vector<GameEngine::Registry::Connection> connections_;
 };
 
 } // namespace rtype::server
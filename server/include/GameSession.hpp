@@ -19,6 +19,7 @@
 #include <string>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace rtype::server {
 
@@ -59,6 +60,14 @@ class GameSession {
 
     size_t client_count() const;
 
+    /// @brief Tick time percentiles of the session systems, empty when RTYPE_PROFILE_SYSTEMS is off
+    std::vector<GameEngine::SystemStats> system_timings() const;
+
+    /// @brief Writes the whole game state into out, see Registry::snapshot()
+    /// @details Meant to be restored into a separate Registry, e.g. for offline benchmarks. A live session is not
+    /// rewound in place: connected clients would only be told that every entity died.
+    void save_checkpoint(std::vector<uint8_t>& out) const;
+
   private:
     void game_loop();
 
@@ -86,8 +95,6 @@ class GameSession {
     void send_entity_spawn(const std::string& ip, uint16_t port, uint32_t entity_id, uint16_t entity_type,
                            uint16_t sub_type, float x, float y, float vx, float vy);
     GameEngine::entity_t create_player_entity(uint32_t player_id, const std::string& player_name);
-    uint16_t get_monster_subtype(const std::string& tag_name);
-    uint16_t get_projectile_subtype(const std::string& tag_name);
 
     uint32_t session_id_;
     UdpServer& udp_server_;
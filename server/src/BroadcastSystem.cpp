@@ -9,11 +9,11 @@
 #include "components/EnemySpawner.hpp"
 #include "components/Score.hpp"
 #include "components/Lives.hpp"
-#include "components/MapBounds.hpp"
 #include "components/HitFlash.hpp"
 #include "components/StageCleared.hpp"
 #include "net/MessageData.hpp"
 #include "utils/Logger.hpp"
+#include <algorithm>
 
 namespace rtype::server {
 
@@ -23,24 +23,47 @@ BroadcastSystem::BroadcastSystem(GameEngine::Registry& registry, UdpServer& udp_
     : registry_(registry), udp_server_(udp_server), protocol_adapter_(protocol_adapter),
       message_serializer_(message_serializer) {
     next_network_id_ = 20000;
+
+    // Spawns are checked once their entity is complete, on the next update; deaths capture the id before removal
+    auto queue_spawn = [this](GameEngine::Registry&, GameEngine::entity_t entity) {
+        pending_spawns_.push_back(entity);
+    };
+    connections_.push_back(registry_.onConstruct<rtype::ecs::component::Position>(queue_spawn));
+    connections_.push_back(registry_.onConstruct<rtype::ecs::component::Velocity>(queue_spawn));
+    connections_.push_back(registry_.onDestroy<rtype::ecs::component::NetworkId>(
+        [this](GameEngine::Registry& registry, GameEngine::entity_t entity) {
+            pending_deaths_.push_back(registry.getComponent<rtype::ecs::component::NetworkId>(entity).id);
+        }));
+
+    auto view = registry_.view<rtype::ecs::component::Position, rtype::ecs::component::Velocity>();
+    for (auto entity : view) {
+        pending_spawns_.push_back(entity);
+    }
+}
+
+BroadcastSystem::~BroadcastSystem() {
+    for (auto connection : connections_) {
+        registry_.disconnect(connection);
+    }
 }
 
 void BroadcastSystem::update(double dt, const std::map<std::string, ClientInfo>& clients) {
-    if (clients.empty())
+    if (clients.empty()) {
+        // Nobody to notify: keep the spawns still alive for the next client, drop the deaths
+        auto destroyed = [this](GameEngine::entity_t entity) {
+            return !registry_.isValid(entity);
+        };
+        pending_spawns_.erase(std::remove_if(pending_spawns_.begin(), pending_spawns_.end(), destroyed),
+                              pending_spawns_.end());
+        pending_deaths_.clear();
         return;
+    }
 
     broadcast_spawns(clients);
     broadcast_deaths(clients);
     broadcast_moves(clients);
     broadcast_stage_cleared(clients);
     broadcast_game_state(clients, dt);
-
-    last_known_entities_.clear();
-    auto view = registry_.view<rtype::ecs::component::NetworkId>();
-    for (auto entity : view) {
-        auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(static_cast<size_t>(entity));
-        last_known_entities_.insert(net_id.id);
-    }
 }
 
 void BroadcastSystem::broadcast_packet(const std::vector<uint8_t>& data,
@@ -60,22 +83,24 @@ void BroadcastSystem::broadcast_spawns(const std::map<std::string, ClientInfo>&
     std::vector<std::pair<rtype::net::EntitySpawnData, std::vector<uint8_t>>> spawns_to_send;
     std::vector<std::pair<size_t, uint32_t>> entities_to_add_network_id;
 
-    auto view = registry_.view<rtype::ecs::component::Position, rtype::ecs::component::Velocity>();
+    std::sort(pending_spawns_.begin(), pending_spawns_.end());
+    pending_spawns_.erase(std::unique(pending_spawns_.begin(), pending_spawns_.end()), pending_spawns_.end());
 
-    for (auto entity : view) {
+    for (auto entity : pending_spawns_) {
         size_t entity_idx = static_cast<size_t>(entity);
 
+        if (!registry_.isValid(entity_idx) ||
+            !registry_.hasComponent<rtype::ecs::component::Position>(entity_idx) ||
+            !registry_.hasComponent<rtype::ecs::component::Velocity>(entity_idx)) {
+            continue;
+        }
+
         if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_idx)) {
             const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_idx);
-            if (tag.name == "Player")
+            if (tag.id == rtype::ecs::tags::Player)
                 continue;
         }
 
-        if (registry_.hasComponent<rtype::ecs::component::EnemySpawner>(entity_idx) ||
-            registry_.hasComponent<rtype::ecs::component::MapBounds>(entity_idx)) {
-            continue;
-        }
-
         if (!registry_.hasComponent<rtype::ecs::component::NetworkId>(entity_idx)) {
             uint32_t net_id = next_network_id_++;
             entities_to_add_network_id.emplace_back(entity_idx, net_id);
@@ -83,82 +108,14 @@ void BroadcastSystem::broadcast_spawns(const std::map<std::string, ClientInfo>&
             auto& pos = registry_.getComponent<rtype::ecs::component::Position>(entity_idx);
             auto& vel = registry_.getComponent<rtype::ecs::component::Velocity>(entity_idx);
 
-            uint16_t type = rtype::net::EntityType::ENEMY;
+            const bool is_projectile = registry_.hasComponent<rtype::ecs::component::Projectile>(entity_idx);
+            uint16_t type = is_projectile ? rtype::net::EntityType::PROJECTILE : rtype::net::EntityType::ENEMY;
             uint16_t sub_type = 0;
-
-            if (registry_.hasComponent<rtype::ecs::component::Projectile>(entity_idx)) {
-                type = rtype::net::EntityType::PROJECTILE;
-            } else if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_idx)) {
-                const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_idx);
-                if (tag.name == "Obstacle" || tag.name == "Obstacle_Floor" || tag.name == "Obstacle_Train_3" ||
-                    tag.name == "Obstacle_Train_4") {
-                    type = rtype::net::EntityType::OBSTACLE;
-                    if (tag.name == "Obstacle_Floor")
-                        sub_type = 1;
-                    else if (tag.name == "Obstacle_Train_3")
-                        sub_type = 2;
-                    else if (tag.name == "Obstacle_Train_4")
-                        sub_type = 3;
-                } else if (tag.name == "ForcePodItem" || tag.name == "ForcePod") {
-                    type = rtype::net::EntityType::POWERUP;
-                    sub_type = (tag.name == "ForcePodItem") ? 1 : 2;
-                }
-            }
-
             if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_idx)) {
                 const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_idx);
-                if (type == rtype::net::EntityType::ENEMY) {
-                    if (tag.name == "Monster_0_Top")
-                        sub_type = 1;
-                    else if (tag.name == "Monster_0_Bot")
-                        sub_type = 2;
-                    else if (tag.name == "Monster_0_Left")
-                        sub_type = 3;
-                    else if (tag.name == "Monster_0_Right")
-                        sub_type = 4;
-                    else if (tag.name == "Boss_1")
-                        sub_type = 100;
-                    else if (tag.name == "Boss_2")
-                        sub_type = 101;
-                    else if (tag.name == "Monster_Wave_2_Left")
-                        sub_type = 5;
-                    else if (tag.name == "Monster_Wave_2_Right")
-                        sub_type = 6;
-                } else if (type == rtype::net::EntityType::PROJECTILE) {
-                    if (tag.name == "Monster_0_Ball")
-                        sub_type = 1;
-                    else if (tag.name == "shot_death-charge1")
-                        sub_type = 10;
-                    else if (tag.name == "shot_death-charge2")
-                        sub_type = 11;
-                    else if (tag.name == "shot_death-charge3")
-                        sub_type = 12;
-                    else if (tag.name == "shot_death-charge4")
-                        sub_type = 13;
-                    else if (tag.name == "Boss_1_Bayblade")
-                        sub_type = 20;
-                    else if (tag.name == "Boss_1_Attack")
-                        sub_type = 21;
-                    else if (tag.name == "Boss_2_Projectile")
-                        sub_type = 22;
-                    else if (tag.name == "Boss_2_Projectile_2")
-                        sub_type = 23;
-                    else if (tag.name == "PodProjectile")
-                        sub_type = 30;
-                    else if (tag.name == "PodProjectileRed") {
-                        sub_type = 31;
-                    } else if (tag.name == "Laser") {
-                        sub_type = 40;
-                    }
-                }
-            }
-
-            if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_idx)) {
-                const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_idx);
-                if (tag.name == "Laser") {
-                    type = rtype::net::EntityType::PROJECTILE;
-                    sub_type = 40;
-                }
+                const auto spawn_type = rtype::ecs::tags::spawnTypeOf(tag.id, is_projectile);
+                type = spawn_type.entityType;
+                sub_type = spawn_type.subType;
             }
 
             rtype::net::EntitySpawnData spawn_data(net_id, type, sub_type, pos.x, pos.y, vel.vx, vel.vy);
@@ -168,6 +125,8 @@ void BroadcastSystem::broadcast_spawns(const std::map<std::string, ClientInfo>&
         }
     }
 
+    pending_spawns_.clear();
+
     for (const auto& [entity_id, net_id] : entities_to_add_network_id) {
         if (registry_.isValid(entity_id)) {
             registry_.addComponent<rtype::ecs::component::NetworkId>(entity_id, net_id);
@@ -181,26 +140,18 @@ void BroadcastSystem::broadcast_spawns(const std::map<std::string, ClientInfo>&
 }
 
 void BroadcastSystem::broadcast_deaths(const std::map<std::string, ClientInfo>& clients) {
-    std::unordered_set<uint32_t> current_entities;
-    auto view = registry_.view<rtype::ecs::component::NetworkId>();
-    for (auto entity : view) {
-        auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(static_cast<size_t>(entity));
-        current_entities.insert(net_id.id);
-    }
-
-    for (uint32_t old_id : last_known_entities_) {
-        if (current_entities.find(old_id) == current_entities.end()) {
-            rtype::net::EntityDestroyData destroy_data;
-            destroy_data.entity_id = old_id;
-            destroy_data.reason = rtype::net::DestroyReason::TIMEOUT;
+    for (uint32_t old_id : pending_deaths_) {
+        rtype::net::EntityDestroyData destroy_data;
+        destroy_data.entity_id = old_id;
+        destroy_data.reason = rtype::net::DestroyReason::TIMEOUT;
 
-            rtype::net::Packet destroy_packet = message_serializer_.serialize_entity_destroy(destroy_data);
-            auto serialized_destroy = protocol_adapter_.serialize(destroy_packet);
+        rtype::net::Packet destroy_packet = message_serializer_.serialize_entity_destroy(destroy_data);
+        auto serialized_destroy = protocol_adapter_.serialize(destroy_packet);
 
-            broadcast_packet(serialized_destroy, clients);
-            Logger::instance().info("Entity destroyed broadcasted: entity_id=" + std::to_string(old_id));
-        }
+        broadcast_packet(serialized_destroy, clients);
+        Logger::instance().info("Entity destroyed broadcasted: entity_id=" + std::to_string(old_id));
     }
+    pending_deaths_.clear();
 }
 
 void BroadcastSystem::broadcast_moves(const std::map<std::string, ClientInfo>& clients) {
@@ -225,25 +176,32 @@ void BroadcastSystem::broadcast_moves(const std::map<std::string, ClientInfo>& c
         broadcast_packet(data, clients);
     }
 
-    std::vector<std::vector<uint8_t>> entity_moves;
-    auto view =
-        registry_
-            .view<rtype::ecs::component::NetworkId, rtype::ecs::component::Position, rtype::ecs::component::Velocity>();
-    for (auto entity : view) {
-        auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(static_cast<size_t>(entity));
+    // Only entities whose Position, Velocity or HitFlash changed since the last broadcast are sent, with a periodic
+    // full refresh so that a lost UDP packet never leaves a client stale for good
+    const uint32_t since = last_move_tick_;
+    last_move_tick_ = registry_.advanceChangeTick();
+    const bool keyframe = ++moves_since_keyframe_ >= MOVE_KEYFRAME_INTERVAL;
+    if (keyframe) {
+        moves_since_keyframe_ = 0;
+    }
 
-        if (registry_.hasComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity))) {
-            const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity));
-            if (tag.name == "Player")
-                continue;
+    std::vector<std::vector<uint8_t>> entity_moves;
+    auto send_move = [&](GameEngine::entity_t entity, const rtype::ecs::component::Position& pos,
+                         const rtype::ecs::component::Velocity& vel) {
+        if (!registry_.hasComponent<rtype::ecs::component::NetworkId>(entity)) {
+            return;
         }
+        auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(entity);
 
-        auto& pos = registry_.getComponent<rtype::ecs::component::Position>(static_cast<size_t>(entity));
-        auto& vel = registry_.getComponent<rtype::ecs::component::Velocity>(static_cast<size_t>(entity));
+        if (registry_.hasComponent<rtype::ecs::component::Tag>(entity)) {
+            const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity);
+            if (tag.id == rtype::ecs::tags::Player)
+                return;
+        }
 
         uint8_t flags = 0;
-        if (registry_.hasComponent<rtype::ecs::component::HitFlash>(static_cast<size_t>(entity))) {
-            auto& flash = registry_.getComponent<rtype::ecs::component::HitFlash>(static_cast<size_t>(entity));
+        if (registry_.hasComponent<rtype::ecs::component::HitFlash>(entity)) {
+            auto& flash = registry_.getComponent<rtype::ecs::component::HitFlash>(entity);
             if (flash.active) {
                 flags |= 0x01;        // Bit 0: is_hit
                 flash.active = false; // Reset after sending
@@ -254,6 +212,28 @@ void BroadcastSystem::broadcast_moves(const std::map<std::string, ClientInfo>& c
         rtype::net::EntityMoveData move_data(net_id.id, pos.x, pos.y, vel.vx, vel.vy, flags);
         rtype::net::Packet move_packet = message_serializer_.serialize_entity_move(move_data);
         entity_moves.push_back(protocol_adapter_.serialize(move_packet));
+    };
+
+    auto movers = registry_.group<rtype::ecs::component::Position, rtype::ecs::component::Velocity>();
+    if (keyframe) {
+        movers.each([&](auto entity, rtype::ecs::component::Position& pos, rtype::ecs::component::Velocity& vel) {
+            send_move(entity, pos, vel);
+        });
+    } else {
+        changed_entities_.clear();
+        auto collect = [this](auto entity, auto&) { changed_entities_.push_back(entity); };
+        registry_.eachChanged<rtype::ecs::component::Position>(since, collect);
+        registry_.eachChanged<rtype::ecs::component::Velocity>(since, collect);
+        registry_.eachChanged<rtype::ecs::component::HitFlash>(since, collect);
+        std::sort(changed_entities_.begin(), changed_entities_.end());
+        changed_entities_.erase(std::unique(changed_entities_.begin(), changed_entities_.end()),
+                                changed_entities_.end());
+        for (auto entity : changed_entities_) {
+            if (movers.contains(entity)) {
+                send_move(entity, registry_.getComponent<rtype::ecs::component::Position>(entity),
+                          registry_.getComponent<rtype::ecs::component::Velocity>(entity));
+            }
+        }
     }
 
     for (const auto& data : entity_moves) {
@@ -268,11 +248,8 @@ void BroadcastSystem::broadcast_game_state(const std::map<std::string, ClientInf
     game_state_data.game_time = 0;
 
     int current_wave_display = 1;
-    auto spawner_view = registry_.view<rtype::ecs::component::EnemySpawner>();
-    for (auto entity : spawner_view) {
-        auto& spawner = registry_.getComponent<rtype::ecs::component::EnemySpawner>(static_cast<size_t>(entity));
-        current_wave_display = (spawner.currentLevel * 100) + (spawner.currentWave + 1);
-        break;
+    if (const auto* spawner = registry_.findContext<rtype::ecs::component::EnemySpawner>()) {
+        current_wave_display = (spawner->currentLevel * 100) + (spawner->currentWave + 1);
     }
     game_state_data.wave_number = static_cast<uint16_t>(current_wave_display);
 
@@ -299,7 +276,7 @@ void BroadcastSystem::broadcast_game_state(const std::map<std::string, ClientInf
 }
 
 void BroadcastSystem::send_initial_state(const std::string& ip, uint16_t port) {
-    auto view = registry_.view<rtype::ecs::component::NetworkId, rtype::ecs::component::Position>();
+    auto view = registry_.query<rtype::ecs::component::NetworkId, rtype::ecs::component::Position>();
     for (auto entity : view) {
         size_t entity_idx = static_cast<size_t>(entity);
         auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(entity_idx);
@@ -312,96 +289,18 @@ void BroadcastSystem::send_initial_state(const std::string& ip, uint16_t port) {
             vy = vel.vy;
         }
 
-        uint16_t type = rtype::net::EntityType::ENEMY;
+        const bool is_projectile = registry_.hasComponent<rtype::ecs::component::Projectile>(entity_idx);
+        uint16_t type = is_projectile ? rtype::net::EntityType::PROJECTILE : rtype::net::EntityType::ENEMY;
         uint16_t sub_type = 0;
-
-        bool is_player = false;
         if (registry_.hasComponent<rtype::ecs::component::Tag>(entity_idx)) {
             const auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(entity_idx);
-            if (tag.name == "Player")
-                is_player = true;
-            else if (tag.name == "Obstacle") {
-                type = rtype::net::EntityType::OBSTACLE;
-            } else if (tag.name == "Obstacle_Floor") {
-                type = rtype::net::EntityType::OBSTACLE;
-                sub_type = 1;
-            } else if (tag.name == "Obstacle_Train_3") {
-                type = rtype::net::EntityType::OBSTACLE;
-                sub_type = 2;
-            } else if (tag.name == "Obstacle_Train_4") {
-                type = rtype::net::EntityType::OBSTACLE;
-                sub_type = 3;
-            } else if (tag.name == "Monster_0_Top")
-                sub_type = 1;
-            else if (tag.name == "Monster_0_Bot")
-                sub_type = 2;
-            else if (tag.name == "Monster_0_Left")
-                sub_type = 3;
-            else if (tag.name == "Monster_0_Right")
-                sub_type = 4;
-            else if (tag.name == "ForcePodItem") {
-                type = rtype::net::EntityType::POWERUP;
-                sub_type = 1;
-            } else if (tag.name == "ForcePod") {
-                type = rtype::net::EntityType::POWERUP;
-                sub_type = 2;
-            }
-
-            if (tag.name == "Monster_0_Ball") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 1;
-            } else if (tag.name == "shot_death-charge1") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 10;
-            } else if (tag.name == "shot_death-charge2") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 11;
-            } else if (tag.name == "shot_death-charge3") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 12;
-            } else if (tag.name == "shot_death-charge4") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 13;
-            } else if (tag.name == "Boss_1") {
-                type = rtype::net::EntityType::ENEMY;
-                sub_type = 100;
-            } else if (tag.name == "Boss_2") {
-                type = rtype::net::EntityType::ENEMY;
-                sub_type = 101;
-            } else if (tag.name == "Monster_Wave_2_Left") {
-                type = rtype::net::EntityType::ENEMY;
-                sub_type = 5;
-            } else if (tag.name == "Monster_Wave_2_Right") {
-                type = rtype::net::EntityType::ENEMY;
-                sub_type = 6;
-            } else if (tag.name == "Boss_1_Bayblade") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 20;
-            } else if (tag.name == "Boss_1_Attack") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 21;
-            } else if (tag.name == "Boss_2_Projectile") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 22;
-            } else if (tag.name == "PodProjectile") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 30;
-            } else if (tag.name == "PodProjectileRed") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 31;
-            } else if (tag.name == "Laser") {
-                type = rtype::net::EntityType::PROJECTILE;
-                sub_type = 40;
-            }
-        }
-
-        if (registry_.hasComponent<rtype::ecs::component::Projectile>(entity_idx)) {
-            type = rtype::net::EntityType::PROJECTILE;
+            if (tag.id == rtype::ecs::tags::Player)
+                continue;
+            const auto spawn_type = rtype::ecs::tags::spawnTypeOf(tag.id, is_projectile);
+            type = spawn_type.entityType;
+            sub_type = spawn_type.subType;
         }
 
-        if (is_player)
-            continue;
-
         rtype::net::EntitySpawnData spawn_data(net_id.id, type, sub_type, pos.x, pos.y, vx, vy);
         rtype::net::Packet spawn_packet = message_serializer_.serialize_entity_spawn(spawn_data);
         send_to_client(protocol_adapter_.serialize(spawn_packet), ip, port);
@@ -1,6 +1,8 @@
 #include "GameSession.hpp"
 #include "net/Protocol.hpp"
 #include "GameConstants.hpp"
+#include "ComponentSnapshots.hpp"
+#include "StaticColliders.hpp"
 #include "utils/GameConfig.hpp"
 #include "utils/Logger.hpp"
 #include "components/Position.hpp"
@@ -29,6 +31,7 @@
 #include "systems/ScoreSystem.hpp"
 #include "systems/LivesSystem.hpp"
 #include "systems/ProjectileSystem.hpp"
+#include <cstdlib>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -43,7 +46,10 @@ void load_level(GameEngine::Registry& registry, const std::string& path) {
         return;
     }
 
+    constexpr float tile_width = 288.0f;
+    constexpr float tile_height = 100.0f;
     static uint32_t next_id = 10000;
+    std::vector<rtype::ecs::StaticColliders::Collider> colliders;
     std::string line;
     int row = 0;
     while (std::getline(file, line)) {
@@ -51,35 +57,34 @@ void load_level(GameEngine::Registry& registry, const std::string& path) {
             char c = line[col];
             if (c == ' ')
                 continue;
-            float x = col * 288.0f, y = row * 100.0f;
+            float x = col * tile_width, y = row * tile_height;
             if (c == '1' || c == '2' || c == '3' || c == '4') {
                 auto e = registry.createEntity();
 
                 float w, h;
-                std::string tag;
+                rtype::ecs::TagId tag;
 
                 if (c == '2') {
                     w = rtype::constants::FLOOR_OBSTACLE_WIDTH * rtype::constants::OBSTACLE_SCALE;
                     h = rtype::constants::FLOOR_OBSTACLE_HEIGHT * rtype::constants::OBSTACLE_SCALE;
-                    tag = "Obstacle_Floor";
+                    tag = rtype::ecs::tags::ObstacleFloor;
                 } else if (c == '3') {
                     w = rtype::constants::FLOOR_OBSTACLE_WIDTH * rtype::constants::OBSTACLE_SCALE;
                     h = rtype::constants::FLOOR_OBSTACLE_HEIGHT * rtype::constants::OBSTACLE_SCALE;
-                    tag = "Obstacle_Train_3";
+                    tag = rtype::ecs::tags::ObstacleTrain3;
                 } else if (c == '4') {
                     w = rtype::constants::OBSTACLE_WIDTH * rtype::constants::OBSTACLE_SCALE;
                     h = rtype::constants::OBSTACLE_HEIGHT * rtype::constants::OBSTACLE_SCALE;
-                    tag = "Obstacle_Train_4";
+                    tag = rtype::ecs::tags::ObstacleTrain4;
                 } else {
                     w = rtype::constants::OBSTACLE_WIDTH * rtype::constants::OBSTACLE_SCALE;
                     h = rtype::constants::OBSTACLE_HEIGHT * rtype::constants::OBSTACLE_SCALE;
-                    tag = "Obstacle";
+                    tag = rtype::ecs::tags::Obstacle;
                 }
 
                 registry.addComponent<rtype::ecs::component::Position>(e, x, y);
                 registry.addComponent<rtype::ecs::component::HitBox>(e, w, h);
-                registry.addComponent<rtype::ecs::component::Collidable>(
-                    e, rtype::ecs::component::CollisionLayer::Obstacle);
+                colliders.push_back({e, x, y, w, h});
                 registry.addComponent<rtype::ecs::component::NetworkId>(e, next_id++);
                 registry.addComponent<rtype::ecs::component::Tag>(e, tag);
                 registry.addComponent<rtype::ecs::component::Velocity>(e, -100.0f, 0.0f);
@@ -87,8 +92,27 @@ void load_level(GameEngine::Registry& registry, const std::string& path) {
         }
         row++;
     }
+    // Obstacles only scroll, CollisionSystem tests them through this grid instead of pairing them with every
+    // collidable each tick
+    registry.emplaceContext<rtype::ecs::StaticColliders>(std::move(colliders), tile_width, tile_height);
     Logger::instance().info("Level loaded from " + path);
 }
+
+// RTYPE_BROADPHASE=brute|buckets|grid|sweep picks how CollisionSystem finds candidate pairs, grid by default
+rtype::ecs::CollisionSystem::Broadphase collision_broadphase() {
+    using Broadphase = rtype::ecs::CollisionSystem::Broadphase;
+    const char* value = std::getenv("RTYPE_BROADPHASE");
+    const std::string name = value ? value : "grid";
+    if (name == "brute")
+        return Broadphase::BruteForce;
+    if (name == "buckets")
+        return Broadphase::LayerBuckets;
+    if (name == "sweep")
+        return Broadphase::SweepAndPrune;
+    if (name != "grid")
+        Logger::instance().warn("Unknown RTYPE_BROADPHASE '" + name + "', using grid");
+    return Broadphase::Grid;
+}
 } // namespace
 
 GameSession::GameSession(uint32_t session_id, UdpServer& udp_server, rtype::net::IProtocolAdapter& protocol_adapter,
@@ -102,13 +126,18 @@ GameSession::GameSession(uint32_t session_id, UdpServer& udp_server, rtype::net:
     system_manager_.addSystem<rtype::ecs::MovementSystem>();
     system_manager_.addSystem<rtype::ecs::MobSystem>();
     system_manager_.addSystem<rtype::ecs::BoundarySystem>();
-    system_manager_.addSystem<rtype::ecs::CollisionSystem>();
+    system_manager_.addSystem<rtype::ecs::CollisionSystem>(collision_broadphase());
     system_manager_.addSystem<rtype::ecs::LivesSystem>();
     system_manager_.addSystem<rtype::ecs::ForcePodSystem>();
     system_manager_.addSystem<rtype::ecs::WeaponSystem>();
     system_manager_.addSystem<rtype::ecs::ProjectileSystem>();
     system_manager_.addSystem<rtype::ecs::ScoreSystem>();
     system_manager_.addSystem<rtype::ecs::SpawnEffectSystem>();
+    rtype::ecs::registerGameplaySnapshots(registry_);
+    // RTYPE_SERIAL_SYSTEMS=1 runs the systems one by one, for debugging ordering issues
+    if (std::getenv("RTYPE_SERIAL_SYSTEMS") == nullptr) {
+        system_manager_.setExecutionMode(GameEngine::SystemManager::ExecutionMode::Parallel);
+    }
 }
 
 GameSession::~GameSession() {
@@ -125,18 +154,12 @@ void GameSession::start() {
 
     {
         std::lock_guard<std::mutex> registry_lock(registry_mutex_);
-        auto boundsEntity = registry_.createEntity();
-        registry_.addComponent<rtype::ecs::component::MapBounds>(boundsEntity, rtype::config::MAP_MIN_X,
-                                                                 rtype::config::MAP_MIN_Y, rtype::config::MAP_MAX_X,
-                                                                 rtype::config::MAP_MAX_Y);
-
-        auto rulesEntity = registry_.createEntity();
-        registry_.addComponent<rtype::ecs::component::GameRulesComponent>(rulesEntity, game_rules_);
+        registry_.emplaceContext<rtype::ecs::component::MapBounds>(rtype::config::MAP_MIN_X, rtype::config::MAP_MIN_Y,
+                                                                   rtype::config::MAP_MAX_X, rtype::config::MAP_MAX_Y);
+        registry_.emplaceContext<rtype::ecs::component::GameRulesComponent>(game_rules_);
+        registry_.emplaceContext<rtype::ecs::component::EnemySpawner>(2.0f, 0.0f);
 
         load_level(registry_, "server/assets/map.txt");
-
-        auto spawner = registry_.createEntity();
-        registry_.addComponent<rtype::ecs::component::EnemySpawner>(spawner, 2.0f, 0.0f);
     }
 
     game_thread_ = std::thread(&GameSession::game_loop, this);
@@ -145,7 +168,9 @@ void GameSession::start() {
 
 void GameSession::stop() {
     running_ = false;
-    if (game_thread_.joinable()) {
+    // Server::stop() and the destructor both land here, only the call that ends the game thread reports
+    const bool had_thread = game_thread_.joinable();
+    if (had_thread) {
         if (std::this_thread::get_id() != game_thread_.get_id()) {
             game_thread_.join();
         } else {
@@ -154,6 +179,27 @@ void GameSession::stop() {
                                     " stopped from within game thread (detached)");
         }
     }
+    if (!had_thread) {
+        return;
+    }
+    for (const auto& stats : system_timings()) {
+        Logger::instance().info("Session " + std::to_string(session_id_) + " " + stats.name +
+                                " p50=" + std::to_string(stats.p50Ms) + "ms p95=" + std::to_string(stats.p95Ms) +
+                                "ms p99=" + std::to_string(stats.p99Ms) + "ms max=" + std::to_string(stats.maxMs) +
+                                "ms entities=" + std::to_string(stats.entities));
+    }
+    std::vector<GameEngine::Registry::QueryStats> query_stats;
+    {
+        // The game thread may still be running when it was detached above
+        std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+        query_stats = registry_.queryStats();
+    }
+    for (const auto& stats : query_stats) {
+        Logger::instance().info("Session " + std::to_string(session_id_) + " query " + stats.name +
+                                " size=" + std::to_string(stats.size) + " runs=" + std::to_string(stats.runs) +
+                                " visited=" + std::to_string(stats.visited) +
+                                " updates=" + std::to_string(stats.updates));
+    }
     Logger::instance().info("Session " + std::to_string(session_id_) + " stopped");
 }
 
@@ -162,6 +208,16 @@ size_t GameSession::client_count() const {
     return clients_.size();
 }
 
+std::vector<GameEngine::SystemStats> GameSession::system_timings() const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    return system_manager_.timings();
+}
+
+void GameSession::save_checkpoint(std::vector<uint8_t>& out) const {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    registry_.snapshot(out);
+}
+
 bool GameSession::handle_player_join(const std::string& client_ip, uint16_t client_port,
                                      const rtype::net::Packet& packet) {
     if (!running_.load())
@@ -404,17 +460,10 @@ void GameSession::game_loop() {
                         for (auto entity : network_view) {
                             bool should_destroy = true;
 
-                            if (registry_.hasComponent<rtype::ecs::component::MapBounds>(static_cast<size_t>(entity))) {
-                                should_destroy = false;
-                            }
-                            if (registry_.hasComponent<rtype::ecs::component::EnemySpawner>(
-                                    static_cast<size_t>(entity))) {
-                                should_destroy = false;
-                            }
                             if (registry_.hasComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity))) {
                                 auto& tag =
                                     registry_.getComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity));
-                                if (tag.name == "Player") {
+                                if (tag.id == rtype::ecs::tags::Player) {
                                     should_destroy = false;
                                 }
                             }
@@ -451,6 +500,8 @@ void GameSession::game_loop() {
             {
                 std::lock_guard<std::mutex> registry_lock(registry_mutex_);
                 std::lock_guard<std::mutex> clients_lock(clients_mutex_);
+                const auto* spawner = registry_.findContext<rtype::ecs::component::EnemySpawner>();
+                const bool boss_warning = spawner && spawner->bossWarningActive;
                 for (const auto& [key, client] : clients_) {
                     if (!client.is_connected)
                         continue;
@@ -459,13 +510,8 @@ void GameSession::game_loop() {
                     state.lives = 0;
                     state.game_state = rtype::net::GameState::PLAYING;
 
-                    auto spawnerView = registry_.view<rtype::ecs::component::EnemySpawner>();
-                    for (auto entity : spawnerView) {
-                        const auto& spawner = registry_.getComponent<rtype::ecs::component::EnemySpawner>(entity);
-                        if (spawner.bossWarningActive) {
-                            state.game_state = rtype::net::GameState::BOSS_WARNING;
-                        }
-                        break;
+                    if (boss_warning) {
+                        state.game_state = rtype::net::GameState::BOSS_WARNING;
                     }
 
                     if (registry_.isValid(client.entity_id)) {
@@ -505,7 +551,7 @@ void GameSession::handle_player_move(const std::string& client_ip, uint16_t clie
         {
             std::lock_guard<std::mutex> lock(registry_mutex_);
             if (registry_.hasComponent<rtype::ecs::component::Velocity>(entity_id)) {
-                auto& vel = registry_.getComponent<rtype::ecs::component::Velocity>(entity_id);
+                auto& vel = registry_.patch<rtype::ecs::component::Velocity>(entity_id);
                 vel.vx = move_data.velocity_x;
                 vel.vy = move_data.velocity_y;
             }
@@ -577,11 +623,9 @@ void GameSession::handle_map_resize(const std::string& client_ip, uint16_t clien
     try {
         auto d = message_serializer_.deserialize_map_resize(packet);
         std::lock_guard<std::mutex> lock(registry_mutex_);
-        for (auto e : registry_.view<rtype::ecs::component::MapBounds>()) {
-            auto& b = registry_.getComponent<rtype::ecs::component::MapBounds>(static_cast<size_t>(e));
-            b.maxX = d.width;
-            b.maxY = d.height;
-            break;
+        if (auto* b = registry_.findContext<rtype::ecs::component::MapBounds>()) {
+            b->maxX = d.width;
+            b->maxY = d.height;
         }
         Logger::instance().info("Session " + std::to_string(session_id_) + " map resized to " +
                                 std::to_string(d.width) + "x" + std::to_string(d.height));
@@ -692,7 +736,8 @@ void GameSession::broadcast_projectile_spawns() {
             projectiles_to_add.emplace_back(id, net_id);
             uint16_t sub_type =
                 registry_.hasComponent<rtype::ecs::component::Tag>(id)
-                    ? get_projectile_subtype(registry_.getComponent<rtype::ecs::component::Tag>(id).name)
+                    ? rtype::ecs::tags::spawnTypeOf(registry_.getComponent<rtype::ecs::component::Tag>(id).id, true)
+                          .subType
                     : 0;
             rtype::net::EntitySpawnData spawn_data(net_id, rtype::net::EntityType::PROJECTILE, sub_type, pos.x, pos.y,
                                                    vel.vx, vel.vy);
@@ -712,54 +757,6 @@ void GameSession::broadcast_projectile_spawns() {
     }
 }
 
-uint16_t GameSession::get_monster_subtype(const std::string& tag_name) {
-    if (tag_name == "Monster_0_Top")
-        return 1;
-    if (tag_name == "Monster_0_Bot")
-        return 2;
-    if (tag_name == "Monster_0_Left")
-        return 3;
-    if (tag_name == "Monster_0_Right")
-        return 4;
-    if (tag_name == "Monster_Wave_2_Left")
-        return 5;
-    if (tag_name == "Monster_Wave_2_Right")
-        return 6;
-    if (tag_name == "Boss_1")
-        return 100;
-    if (tag_name == "Boss_2")
-        return 101;
-    return 0;
-}
-
-uint16_t GameSession::get_projectile_subtype(const std::string& tag_name) {
-    if (tag_name == "Monster_0_Ball")
-        return 1;
-    if (tag_name == "shot_death-charge1")
-        return 10;
-    if (tag_name == "shot_death-charge2")
-        return 11;
-    if (tag_name == "shot_death-charge3")
-        return 12;
-    if (tag_name == "shot_death-charge4")
-        return 13;
-    if (tag_name == "Boss_1_Bayblade")
-        return 20;
-    if (tag_name == "Boss_1_Attack")
-        return 21;
-    if (tag_name == "Boss_2_Projectile")
-        return 22;
-    if (tag_name == "Boss_2_Projectile_2")
-        return 23;
-    if (tag_name == "PodProjectile")
-        return 30;
-    if (tag_name == "PodProjectileRed")
-        return 31;
-    if (tag_name == "Laser")
-        return 40;
-    return 0;
-}
-
 void GameSession::send_entity_spawn(const std::string& ip, uint16_t port, uint32_t entity_id, uint16_t entity_type,
                                     uint16_t sub_type, float x, float y, float vx, float vy) {
     rtype::net::EntitySpawnData spawn_data(entity_id, entity_type, sub_type, x, y, vx, vy);
@@ -784,7 +781,7 @@ GameEngine::entity_t GameSession::create_player_entity(uint32_t player_id, const
     registry_.addComponent<rtype::ecs::component::Health>(entity, 100, 100);
     registry_.addComponent<rtype::ecs::component::Score>(entity, 0);
     registry_.addComponent<rtype::ecs::component::Lives>(entity, game_rules_.initial_lives);
-    registry_.addComponent<rtype::ecs::component::Tag>(entity, "Player");
+    registry_.addComponent<rtype::ecs::component::Tag>(entity, rtype::ecs::tags::Player);
     registry_.addComponent<rtype::ecs::component::NetworkId>(entity, player_id);
     registry_.addComponent<rtype::ecs::component::Collidable>(entity, rtype::ecs::component::CollisionLayer::Player);
     registry_.addComponent<rtype::ecs::component::PlayerName>(entity, player_name);
@@ -796,7 +793,7 @@ void GameSession::send_existing_entities_to_client(const std::string& client_ip,
         registry_.view<rtype::ecs::component::NetworkId, rtype::ecs::component::Position, rtype::ecs::component::Tag>();
     for (auto entity : obstacle_view) {
         auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity));
-        if (tag.name != "Obstacle" && tag.name != "Obstacle_Floor")
+        if (tag.id != rtype::ecs::tags::Obstacle && tag.id != rtype::ecs::tags::ObstacleFloor)
             continue;
         auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(static_cast<size_t>(entity));
         auto& pos = registry_.getComponent<rtype::ecs::component::Position>(static_cast<size_t>(entity));
@@ -807,7 +804,7 @@ void GameSession::send_existing_entities_to_client(const std::string& client_ip,
             vy = vel.vy;
         }
         send_entity_spawn(client_ip, client_port, net_id.id, rtype::net::EntityType::OBSTACLE,
-                          (tag.name == "Obstacle_Floor") ? 1 : 0, pos.x, pos.y, vx, vy);
+                          rtype::ecs::tags::spawnTypeOf(tag.id, false).subType, pos.x, pos.y, vx, vy);
     }
 
     auto enemy_view = registry_.view<rtype::ecs::component::NetworkId, rtype::ecs::component::Position,
@@ -815,13 +812,13 @@ void GameSession::send_existing_entities_to_client(const std::string& client_ip,
     for (auto entity : enemy_view) {
         if (registry_.hasComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity))) {
             auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity));
-            if (tag.name == "Player")
+            if (tag.id == rtype::ecs::tags::Player)
                 continue;
             auto& net_id = registry_.getComponent<rtype::ecs::component::NetworkId>(static_cast<size_t>(entity));
             auto& pos = registry_.getComponent<rtype::ecs::component::Position>(static_cast<size_t>(entity));
             auto& vel = registry_.getComponent<rtype::ecs::component::Velocity>(static_cast<size_t>(entity));
             send_entity_spawn(client_ip, client_port, net_id.id, rtype::net::EntityType::ENEMY,
-                              get_monster_subtype(tag.name), pos.x, pos.y, vel.vx, vel.vy);
+                              rtype::ecs::tags::spawnTypeOf(tag.id, false).subType, pos.x, pos.y, vel.vx, vel.vy);
         }
     }
 
@@ -834,7 +831,7 @@ void GameSession::send_existing_entities_to_client(const std::string& client_ip,
         uint16_t sub_type = 0;
         if (registry_.hasComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity))) {
             auto& tag = registry_.getComponent<rtype::ecs::component::Tag>(static_cast<size_t>(entity));
-            sub_type = get_projectile_subtype(tag.name);
+            sub_type = rtype::ecs::tags::spawnTypeOf(tag.id, true).subType;
         }
         send_entity_spawn(client_ip, client_port, net_id.id, rtype::net::EntityType::PROJECTILE, sub_type, pos.x, pos.y,
                           vel.vx, vel.vy);
@@ -1039,37 +1036,21 @@ void GameSession::reset_game_for_restart() {
         std::vector<GameEngine::entity_t> entities_to_destroy;
         auto network_view = registry_.view<rtype::ecs::component::NetworkId>();
         for (auto entity : network_view) {
-            bool should_destroy = true;
-
-            if (registry_.hasComponent<rtype::ecs::component::MapBounds>(static_cast<size_t>(entity))) {
-                should_destroy = false;
-            }
-            if (registry_.hasComponent<rtype::ecs::component::EnemySpawner>(static_cast<size_t>(entity))) {
-                should_destroy = false;
-            }
-            if (registry_.hasComponent<rtype::ecs::component::GameRulesComponent>(static_cast<size_t>(entity))) {
-                should_destroy = false;
-            }
-
-            if (should_destroy) {
-                entities_to_destroy.push_back(static_cast<GameEngine::entity_t>(entity));
-            }
+            entities_to_destroy.push_back(static_cast<GameEngine::entity_t>(entity));
         }
 
         for (auto entity : entities_to_destroy) {
             registry_.destroyEntity(entity);
         }
 
-        auto spawnerView = registry_.view<rtype::ecs::component::EnemySpawner>();
-        for (auto entity : spawnerView) {
-            auto& spawner = registry_.getComponent<rtype::ecs::component::EnemySpawner>(entity);
-            spawner.timeSinceLastSpawn = 0.0f;
-            spawner.bossWarningActive = false;
-            spawner.bossWarningTimer = 0.0f;
-            spawner.currentWave = 0;
-            spawner.currentLevel = 0;
-            spawner.currentEnemyIndex = 0;
-            spawner.waveTimer = 0.0f;
+        if (auto* spawner = registry_.findContext<rtype::ecs::component::EnemySpawner>()) {
+            spawner->timeSinceLastSpawn = 0.0f;
+            spawner->bossWarningActive = false;
+            spawner->bossWarningTimer = 0.0f;
+            spawner->currentWave = 0;
+            spawner->currentLevel = 0;
+            spawner->currentEnemyIndex = 0;
+            spawner->waveTimer = 0.0f;
         }
     }
 
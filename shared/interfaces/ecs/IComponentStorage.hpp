@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include "IEntityRegistry.hpp"
+
+namespace GameEngine {
+
+/// @brief Type-erased view of a component storage, lets the registry manage storages without knowing their type
+class IComponentStorage {
+  public:
+    virtual ~IComponentStorage() = default;
+
+    /// @brief Checks if the entity has a component in this storage
+    virtual bool contains(entity_t entity) const = 0;
+
+    /// @brief Removes the entity's component if present
+    virtual void remove(entity_t entity) = 0;
+
+    /// @brief Removes every component while keeping the allocated capacity
+    virtual void clear() = 0;
+
+    /// @brief Number of stored components
+    virtual std::size_t size() const = 0;
+
+    /// @brief Bytes reserved by the storage itself (heap owned by the components is not counted)
+    virtual std::size_t memoryUsage() const = 0;
+};
+
+} // namespace GameEngine
@@ -6,6 +6,8 @@ class Registry;
 
 namespace rtype::ecs {
 
+class SystemAccess;
+
 class ISystem {
   public:
     virtual ~ISystem() = default;
@@ -15,6 +17,15 @@ class ISystem {
      * @param registry The entity registry.
      */
     virtual void update(GameEngine::Registry& registry, double dt) = 0;
+
+    /**
+     * @brief Declares the components the system reads and writes.
+     * @details Systems that leave the access empty are scheduled alone.
+     * @param access The access descriptor to fill.
+     */
+    virtual void declareAccess(SystemAccess& access) const {
+        (void)access;
+    }
 };
 
 } // namespace rtype::ecs
@@ -24,8 +24,12 @@ class IRenderer {
   public:
     virtual ~IRenderer() = default;
 
+    /// @brief Queues a sprite, it may only reach the screen at the next flush()
     virtual void draw_sprite(const RenderData& data) = 0;
 
+    /// @brief Draws the queued sprites, before anything is drawn on top of them outside the renderer
+    virtual void flush() = 0;
+
     virtual void clear() = 0;
 
     virtual void display() = 0;
@@ -13,6 +13,9 @@ class NullRenderer : public IRenderer {
         (void)data;
     }
 
+    void flush() override {
+    }
+
     void clear() override {
     }
 
@@ -29,6 +32,11 @@ class NullRenderer : public IRenderer {
         (void)out_height;
         return false;
     }
+
+    void draw_parallax_background(const std::string& texture_name, float view_y) override {
+        (void)texture_name;
+        (void)view_y;
+    }
 };
 
 } // namespace rtype::rendering
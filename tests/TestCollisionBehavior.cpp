@@ -6,7 +6,15 @@
 #include "components/Velocity.hpp"
 #include "components/HitBox.hpp"
 #include "components/CollisionLayer.hpp"
+#include "components/Health.hpp"
+#include "components/GameRulesComponent.hpp"
+#include "AabbKernel.hpp"
+#include "StaticColliders.hpp"
 #include "GameConstants.hpp"
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <random>
 
 TEST_CASE("Player vs Obstacle Stop Test", "[collision]") {
     GameEngine::Registry registry;
@@ -37,3 +45,243 @@ TEST_CASE("Player vs Obstacle Stop Test", "[collision]") {
     REQUIRE(finalPos.x < 300.0f);
     REQUIRE(finalPos.x <= 140.0f);
 }
+
+namespace {
+
+// Crowded scene: players, enemies, projectiles both ways, power-ups and obstacles, some beyond the map edges
+void populateCollisionScene(GameEngine::Registry& registry) {
+    using namespace rtype::ecs::component;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> x(-200.0f, 2100.0f);
+    std::uniform_real_distribution<float> y(-100.0f, 1150.0f);
+    std::uniform_real_distribution<float> speed(-400.0f, 400.0f);
+    std::uniform_real_distribution<float> size(8.0f, 300.0f);
+    const CollisionLayer layers[] = {CollisionLayer::Player,           CollisionLayer::Enemy,
+                                     CollisionLayer::PlayerProjectile, CollisionLayer::EnemyProjectile,
+                                     CollisionLayer::PowerUp,          CollisionLayer::Obstacle};
+    for (int i = 0; i < 400; ++i) {
+        auto entity = registry.createEntity();
+        const CollisionLayer layer = layers[i % 6];
+        registry.addComponent<Position>(entity, x(rng), y(rng));
+        if (layer != CollisionLayer::Obstacle) {
+            registry.addComponent<Velocity>(entity, speed(rng), speed(rng));
+        }
+        const float side = layer == CollisionLayer::PlayerProjectile || layer == CollisionLayer::EnemyProjectile
+                               ? size(rng) / 8.0f
+                               : size(rng);
+        registry.addComponent<HitBox>(entity, side, side * 0.75f);
+        registry.addComponent<Collidable>(entity, layer);
+        if (layer == CollisionLayer::Player || layer == CollisionLayer::Enemy) {
+            registry.addComponent<Health>(entity, Health{100, 100});
+        }
+    }
+}
+
+// Compares two registries entity by entity, returns how many entities are alive
+std::size_t sameOutcome(GameEngine::Registry& expected, GameEngine::Registry& actual) {
+    using namespace rtype::ecs::component;
+    std::size_t alive = 0;
+    for (GameEngine::entity_t entity = 0; entity < 1000; ++entity) {
+        REQUIRE(expected.isValid(entity) == actual.isValid(entity));
+        if (!expected.isValid(entity)) {
+            continue;
+        }
+        ++alive;
+        REQUIRE(expected.hasComponent<Position>(entity) == actual.hasComponent<Position>(entity));
+        if (expected.hasComponent<Position>(entity)) {
+            REQUIRE(expected.getComponent<Position>(entity).x == actual.getComponent<Position>(entity).x);
+            REQUIRE(expected.getComponent<Position>(entity).y == actual.getComponent<Position>(entity).y);
+        }
+        REQUIRE(expected.hasComponent<Health>(entity) == actual.hasComponent<Health>(entity));
+        if (expected.hasComponent<Health>(entity)) {
+            REQUIRE(expected.getComponent<Health>(entity).hp == actual.getComponent<Health>(entity).hp);
+        }
+    }
+    REQUIRE(alive > 0);
+    return alive;
+}
+
+
+// Runs the scene through the brute-force loop and through mode, then compares the outcome entity by entity. With
+// interleaved, every third tick runs on the grid, leaving the persistent state of mode a tick behind.
+void compareWithBruteForce(rtype::ecs::CollisionSystem::Broadphase mode, bool friendlyFire, bool interleaved = false) {
+    using rtype::ecs::CollisionSystem;
+    using namespace rtype::ecs::component;
+
+    GameEngine::Registry bruteRegistry;
+    GameEngine::Registry indexedRegistry;
+    for (auto* registry : {&bruteRegistry, &indexedRegistry}) {
+        registry->emplaceContext<GameRulesComponent>().rules.friendly_fire_enabled = friendlyFire;
+        populateCollisionScene(*registry);
+    }
+
+    CollisionSystem brute;
+    brute.setBroadphase(CollisionSystem::Broadphase::BruteForce);
+    CollisionSystem indexed;
+    REQUIRE(indexed.broadphase() == CollisionSystem::Broadphase::Grid);
+    indexed.setBroadphase(mode);
+    rtype::ecs::MovementSystem movement;
+
+    for (int tick = 0; tick < 20; ++tick) {
+        std::srand(static_cast<unsigned>(tick));
+        movement.update(bruteRegistry, 0.016);
+        brute.update(bruteRegistry, 0.016);
+        std::srand(static_cast<unsigned>(tick));
+        movement.update(indexedRegistry, 0.016);
+        if (interleaved) {
+            indexed.setBroadphase(tick % 3 == 2 ? CollisionSystem::Broadphase::Grid : mode);
+        }
+        indexed.update(indexedRegistry, 0.016);
+    }
+
+    REQUIRE(sameOutcome(bruteRegistry, indexedRegistry) < 400);
+}
+
+// Level laid out like load_level does, scrolled by -150 px: obstacles first, then a crowd of dynamic collidables.
+// Obstacles are ordinary collidables, or left out of the collidables and listed in a StaticColliders context.
+void populateScrolledLevel(GameEngine::Registry& registry, bool staticObstacles) {
+    using namespace rtype::ecs::component;
+    const char* level[] = {"43434334333343334343334334334343", "", "", "", "", "", "",
+                           "  1  1 1   1  1   1  1     1   1", "22222222222222222222222222222222"};
+    std::vector<rtype::ecs::StaticColliders::Collider> colliders;
+    for (int row = 0; row < 9; ++row) {
+        for (int col = 0; level[row][col] != '\0'; ++col) {
+            if (level[row][col] == ' ') {
+                continue;
+            }
+            const bool floor = level[row][col] == '2' || level[row][col] == '3';
+            const float w = (floor ? rtype::constants::FLOOR_OBSTACLE_WIDTH : rtype::constants::OBSTACLE_WIDTH) *
+                            rtype::constants::OBSTACLE_SCALE;
+            const float h = (floor ? rtype::constants::FLOOR_OBSTACLE_HEIGHT : rtype::constants::OBSTACLE_HEIGHT) *
+                            rtype::constants::OBSTACLE_SCALE;
+            auto entity = registry.createEntity();
+            registry.addComponent<Position>(entity, col * 288.0f - 150.0f, row * 100.0f);
+            registry.addComponent<Velocity>(entity, -100.0f, 0.0f);
+            registry.addComponent<HitBox>(entity, w, h);
+            if (staticObstacles) {
+                colliders.push_back({entity, col * 288.0f, row * 100.0f, w, h});
+            } else {
+                registry.addComponent<Collidable>(entity, CollisionLayer::Obstacle);
+            }
+        }
+    }
+    if (staticObstacles) {
+        registry.emplaceContext<rtype::ecs::StaticColliders>(std::move(colliders), 288.0f, 100.0f);
+    }
+    std::mt19937 rng(77);
+    std::uniform_real_distribution<float> x(-100.0f, 2000.0f);
+    std::uniform_real_distribution<float> y(-50.0f, 1100.0f);
+    std::uniform_real_distribution<float> speed(-400.0f, 400.0f);
+    const CollisionLayer layers[] = {CollisionLayer::Player, CollisionLayer::Enemy, CollisionLayer::PlayerProjectile,
+                                     CollisionLayer::EnemyProjectile};
+    for (int i = 0; i < 200; ++i) {
+        auto entity = registry.createEntity();
+        const CollisionLayer layer = layers[i % 4];
+        registry.addComponent<Position>(entity, x(rng), y(rng));
+        registry.addComponent<Velocity>(entity, speed(rng), speed(rng));
+        registry.addComponent<HitBox>(entity, 60.0f, 40.0f);
+        registry.addComponent<Collidable>(entity, layer);
+        if (layer == CollisionLayer::Player || layer == CollisionLayer::Enemy) {
+            registry.addComponent<Health>(entity, Health{100, 100});
+        }
+    }
+    // The level scrolled past its first obstacle
+    registry.destroyEntity(0);
+}
+
+} // namespace
+
+TEST_CASE("Broadphases match brute force collisions", "[collision]") {
+    using Broadphase = rtype::ecs::CollisionSystem::Broadphase;
+    for (bool friendlyFire : {false, true}) {
+        compareWithBruteForce(Broadphase::LayerBuckets, friendlyFire);
+        compareWithBruteForce(Broadphase::Grid, friendlyFire);
+        compareWithBruteForce(Broadphase::SweepAndPrune, friendlyFire);
+        compareWithBruteForce(Broadphase::SweepAndPrune, friendlyFire, true);
+    }
+}
+
+TEST_CASE("Collision layer matrix is symmetric and gates friendly fire", "[collision]") {
+    using rtype::ecs::component::CollisionLayer;
+    using rtype::ecs::component::layersInteract;
+
+    for (std::size_t a = 0; a < rtype::ecs::component::CollisionLayerCount; ++a) {
+        for (std::size_t b = 0; b < rtype::ecs::component::CollisionLayerCount; ++b) {
+            for (bool friendlyFire : {false, true}) {
+                REQUIRE(layersInteract(static_cast<CollisionLayer>(a), static_cast<CollisionLayer>(b), friendlyFire) ==
+                        layersInteract(static_cast<CollisionLayer>(b), static_cast<CollisionLayer>(a), friendlyFire));
+            }
+        }
+    }
+    REQUIRE(layersInteract(CollisionLayer::Enemy, CollisionLayer::PlayerProjectile));
+    REQUIRE(layersInteract(CollisionLayer::Obstacle, CollisionLayer::Player));
+    REQUIRE_FALSE(layersInteract(CollisionLayer::Enemy, CollisionLayer::Enemy));
+    REQUIRE_FALSE(layersInteract(CollisionLayer::EnemyProjectile, CollisionLayer::EnemyProjectile));
+    REQUIRE_FALSE(layersInteract(CollisionLayer::None, CollisionLayer::Obstacle));
+    REQUIRE_FALSE(layersInteract(CollisionLayer::Player, CollisionLayer::PlayerProjectile));
+    REQUIRE(layersInteract(CollisionLayer::Player, CollisionLayer::PlayerProjectile, true));
+    REQUIRE(layersInteract(CollisionLayer::Player, CollisionLayer::Player, true));
+}
+
+TEST_CASE("Overlap kernel matches the scalar AABB test", "[collision]") {
+    std::mt19937 rng(99);
+    // Coarse coordinates so that many boxes share an edge, which must not count as overlapping
+    std::uniform_int_distribution<int> coord(0, 12);
+    std::uniform_int_distribution<int> extent(0, 4);
+    auto scalar = [](float x1, float y1, float w1, float h1, float x2, float y2, float w2, float h2) {
+        return x1 < x2 + w2 && x1 + w1 > x2 && y1 < y2 + h2 && y1 + h1 > y2;
+    };
+
+    rtype::ecs::AabbBlock block;
+    std::vector<std::array<float, 4>> boxes;
+    for (int n = 0; n < 203; ++n) {
+        std::array<float, 4> box{coord(rng) * 0.5f, coord(rng) * 0.5f, extent(rng) * 0.5f, extent(rng) * 0.5f};
+        if (n == 17) {
+            box[0] = std::nanf("");
+        }
+        boxes.push_back(box);
+        block.push(box[0], box[1], box[2], box[3]);
+    }
+    REQUIRE(block.size() == boxes.size());
+
+    for (int query = 0; query < 200; ++query) {
+        const float x = coord(rng) * 0.5f;
+        const float y = coord(rng) * 0.5f;
+        const float w = extent(rng) * 0.5f;
+        const float h = extent(rng) * 0.5f;
+        for (std::size_t first = 0; first < boxes.size(); first += 64) {
+            const std::uint64_t mask = rtype::ecs::overlapMask(block, first, x, y, w, h);
+            for (std::size_t k = 0; k < 64; ++k) {
+                bool expected = false;
+                if (first + k < boxes.size()) {
+                    const auto& box = boxes[first + k];
+                    expected = scalar(x, y, w, h, box[0], box[1], box[2], box[3]);
+                }
+                REQUIRE(((mask >> k) & 1) == (expected ? 1u : 0u));
+            }
+        }
+    }
+    REQUIRE(rtype::ecs::overlapMask(block, boxes.size(), 0.0f, 0.0f, 10.0f, 10.0f) == 0);
+}
+
+TEST_CASE("Static level obstacles collide like ordinary obstacles", "[collision]") {
+    GameEngine::Registry dynamicRegistry;
+    GameEngine::Registry staticRegistry;
+    populateScrolledLevel(dynamicRegistry, false);
+    populateScrolledLevel(staticRegistry, true);
+
+    rtype::ecs::CollisionSystem dynamicCollisions;
+    dynamicCollisions.setBroadphase(rtype::ecs::CollisionSystem::Broadphase::BruteForce);
+    rtype::ecs::CollisionSystem staticCollisions;
+    rtype::ecs::MovementSystem movement;
+    for (int tick = 0; tick < 30; ++tick) {
+        std::srand(static_cast<unsigned>(tick));
+        movement.update(dynamicRegistry, 0.016);
+        dynamicCollisions.update(dynamicRegistry, 0.016);
+        std::srand(static_cast<unsigned>(tick));
+        movement.update(staticRegistry, 0.016);
+        staticCollisions.update(staticRegistry, 0.016);
+    }
+    REQUIRE(sameOutcome(dynamicRegistry, staticRegistry) < 260);
+    REQUIRE(staticRegistry.context<rtype::ecs::StaticColliders>().size() == 73);
+}
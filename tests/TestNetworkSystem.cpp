@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "NetworkSystem.hpp"
+#include "NetworkIdIndex.hpp"
 #include "Registry.hpp"
 #include "components/Position.hpp"
 #include "components/NetworkId.hpp"
@@ -95,3 +96,39 @@ TEST_CASE("NetworkSystem handles Spawn, Move, and Destroy packets", "[NetworkSys
         REQUIRE_FALSE(found);
     }
 }
+
+TEST_CASE("NetworkIdIndex follows spawns, destroys and registry resets", "[NetworkSystem]") {
+    GameEngine::Registry registry;
+    std::mutex registry_mutex;
+    rtype::client::NetworkSystem networkSystem;
+    rtype::net::MessageSerializer serializer;
+
+    auto existing = registry.createEntity();
+    registry.addComponent<rtype::ecs::component::NetworkId>(existing, 7u);
+    auto& index = rtype::ecs::NetworkIdIndex::of(registry);
+    REQUIRE(&index == &rtype::ecs::NetworkIdIndex::of(registry));
+    REQUIRE(index.find(7) == existing);
+
+    for (uint32_t id = 200; id < 205; ++id) {
+        rtype::net::EntitySpawnData spawnData;
+        spawnData.entity_id = id;
+        networkSystem.push_packet(serializer.serialize_entity_spawn(spawnData));
+    }
+    networkSystem.update(registry, registry_mutex);
+    REQUIRE(index.size() == 6);
+    auto spawned = index.find(203);
+    REQUIRE(spawned.has_value());
+    REQUIRE(registry.getComponent<rtype::ecs::component::NetworkId>(*spawned).id == 203);
+
+    rtype::net::EntityDestroyData destroyData;
+    destroyData.entity_id = 203;
+    networkSystem.push_packet(serializer.serialize_entity_destroy(destroyData));
+    networkSystem.update(registry, registry_mutex);
+    REQUIRE_FALSE(index.find(203).has_value());
+    REQUIRE_FALSE(registry.isValid(*spawned));
+    REQUIRE(index.find(204).has_value());
+
+    registry.clear();
+    REQUIRE(index.size() == 0);
+    REQUIRE_FALSE(index.find(7).has_value());
+}
@@ -0,0 +1,809 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ComponentFamily.hpp"
+#include "Registry.hpp"
+#include "CommandBuffer.hpp"
+#include "ComponentSnapshots.hpp"
+#include "SystemManager.hpp"
+#include "SparseSet.hpp"
+#include "components/Position.hpp"
+#include "components/Drawable.hpp"
+#include "components/Tag.hpp"
+#include "components/UITag.hpp"
+#include "components/Velocity.hpp"
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("SparseSet keeps components packed", "[SparseSet]") {
+    rtype::ecs::SparseSet<rtype::ecs::component::Position> storage;
+
+    storage.emplace_at(5, 5.0f, 0.0f);
+    storage.emplace_at(100, 100.0f, 0.0f);
+    storage.emplace_at(42, 42.0f, 0.0f);
+
+    REQUIRE(storage.size() == 3);
+    REQUIRE(storage.contains(100));
+    REQUIRE_FALSE(storage.contains(6));
+
+    storage.erase(5);
+
+    REQUIRE(storage.size() == 2);
+    REQUIRE_FALSE(storage.contains(5));
+    REQUIRE(storage.get(100).x == 100.0f);
+    REQUIRE(storage.get(42).x == 42.0f);
+
+    float sum = 0.0f;
+    for (const auto& pos : storage) {
+        sum += pos.x;
+    }
+    REQUIRE(sum == 142.0f);
+}
+
+TEST_CASE("Registry adds, replaces and removes components", "[Registry]") {
+    GameEngine::Registry registry;
+
+    auto a = registry.createEntity();
+    auto b = registry.createEntity();
+    registry.addComponent<rtype::ecs::component::Position>(a, 1.0f, 2.0f);
+    registry.addComponent<rtype::ecs::component::Position>(b, 3.0f, 4.0f);
+
+    registry.addComponent<rtype::ecs::component::Position>(a, 10.0f, 20.0f);
+    REQUIRE(registry.getComponent<rtype::ecs::component::Position>(a).x == 10.0f);
+
+    registry.removeComponent<rtype::ecs::component::Position>(a);
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Position>(a));
+    REQUIRE(registry.getComponent<rtype::ecs::component::Position>(b).y == 4.0f);
+    REQUIRE_THROWS(registry.getComponent<rtype::ecs::component::Position>(a));
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Velocity>(b));
+}
+
+TEST_CASE("Registry recycles destroyed entity slots with a new generation", "[Registry]") {
+    GameEngine::Registry registry;
+
+    auto first = registry.createEntity();
+    registry.addComponent<rtype::ecs::component::Position>(first, 1.0f, 1.0f);
+    registry.destroyEntity(first);
+    REQUIRE_FALSE(registry.isValid(first));
+
+    auto second = registry.createEntity();
+    REQUIRE(rtype::ecs::entity::index(second) == rtype::ecs::entity::index(first));
+    REQUIRE(second != first);
+    REQUIRE(registry.isValid(second));
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Position>(second));
+
+    registry.addComponent<rtype::ecs::component::Position>(second, 5.0f, 5.0f);
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Position>(first));
+    REQUIRE(registry.getComponent<rtype::ecs::component::Position>(second).x == 5.0f);
+
+    REQUIRE_THROWS(registry.addComponent<rtype::ecs::component::Position>(first, 9.0f, 9.0f));
+    REQUIRE_THROWS(registry.addComponent<rtype::ecs::component::Velocity>(first, 1.0f, 1.0f));
+    REQUIRE(registry.getComponent<rtype::ecs::component::Position>(second).x == 5.0f);
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Position>(first));
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Velocity>(second));
+
+    registry.destroyEntity(first);
+    REQUIRE(registry.isValid(second));
+    REQUIRE_FALSE(registry.isValid(rtype::ecs::entity::make(42, 0)));
+
+    registry.clear();
+    REQUIRE_FALSE(registry.isValid(second));
+    REQUIRE(rtype::ecs::entity::index(registry.createEntity()) == 0);
+}
+
+TEST_CASE("Registry releases components on destroy and keeps capacity on clear", "[Registry]") {
+    GameEngine::Registry registry;
+
+    auto kept = registry.createEntity();
+    auto dead = registry.createEntity();
+    registry.addComponent<rtype::ecs::component::Position>(kept, 1.0f, 1.0f);
+    registry.addComponent<rtype::ecs::component::Position>(dead, 2.0f, 2.0f);
+    registry.addComponent<rtype::ecs::component::Tag>(dead, "projectile");
+
+    registry.destroyEntity(dead);
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Tag>(dead));
+    REQUIRE(registry.view<rtype::ecs::component::Tag>().empty());
+    REQUIRE(registry.getComponent<rtype::ecs::component::Position>(kept).x == 1.0f);
+
+    const std::size_t reserved = registry.componentMemoryUsage();
+    registry.clear();
+    REQUIRE_FALSE(registry.hasComponent<rtype::ecs::component::Position>(kept));
+    REQUIRE(registry.componentMemoryUsage() == reserved);
+}
+
+TEST_CASE("View walks matching entities and tolerates structural changes", "[Registry]") {
+    GameEngine::Registry registry;
+
+    std::vector<GameEngine::entity_t> moving;
+    for (int i = 0; i < 6; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<rtype::ecs::component::Position>(entity, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0) {
+            registry.addComponent<rtype::ecs::component::Velocity>(entity, 1.0f, 0.0f);
+            moving.push_back(entity);
+        }
+    }
+
+    auto view = registry.view<rtype::ecs::component::Position, rtype::ecs::component::Velocity>();
+    REQUIRE(view.sizeHint() == moving.size());
+
+    int visited = 0;
+    view.each([&](auto entity, rtype::ecs::component::Position& pos, rtype::ecs::component::Velocity& vel) {
+        pos.x += vel.vx;
+        ++visited;
+        auto spawned = registry.createEntity();
+        registry.addComponent<rtype::ecs::component::Position>(spawned, 0.0f, 0.0f);
+        registry.addComponent<rtype::ecs::component::Velocity>(spawned, 0.0f, 0.0f);
+        registry.destroyEntity(entity);
+    });
+
+    REQUIRE(visited == static_cast<int>(moving.size()));
+    for (auto entity : moving) {
+        REQUIRE_FALSE(registry.isValid(entity));
+    }
+
+    int remaining = 0;
+    for (auto entity : registry.view<rtype::ecs::component::Velocity>()) {
+        REQUIRE(registry.hasComponent<rtype::ecs::component::Position>(entity));
+        ++remaining;
+    }
+    REQUIRE(remaining == static_cast<int>(moving.size()));
+}
+
+TEST_CASE("Component family ids are dense and stable", "[Registry]") {
+    const auto position = rtype::ecs::ComponentFamily::id<rtype::ecs::component::Position>();
+    const auto velocity = rtype::ecs::ComponentFamily::id<rtype::ecs::component::Velocity>();
+
+    REQUIRE(position != velocity);
+    REQUIRE(rtype::ecs::ComponentFamily::id<rtype::ecs::component::Position>() == position);
+    REQUIRE(rtype::ecs::ComponentFamily::id<const rtype::ecs::component::Position&>() == position);
+}
+
+TEST_CASE("Owning group keeps its storages aligned", "[Registry]") {
+    GameEngine::Registry registry;
+    auto movers = registry.group<rtype::ecs::component::Position, rtype::ecs::component::Velocity>();
+
+    std::vector<GameEngine::entity_t> entities;
+    for (int i = 0; i < 5; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<rtype::ecs::component::Position>(entity, static_cast<float>(i), 0.0f);
+        if (i != 2) {
+            registry.addComponent<rtype::ecs::component::Velocity>(entity, static_cast<float>(i), 0.0f);
+        }
+        entities.push_back(entity);
+    }
+
+    REQUIRE(movers.size() == 4);
+    REQUIRE_FALSE(movers.contains(entities[2]));
+    movers.each([](auto, rtype::ecs::component::Position& pos, rtype::ecs::component::Velocity& vel) {
+        REQUIRE(pos.x == vel.vx);
+    });
+
+    registry.removeComponent<rtype::ecs::component::Velocity>(entities[0]);
+    registry.destroyEntity(entities[3]);
+    registry.addComponent<rtype::ecs::component::Velocity>(entities[2], 2.0f, 0.0f);
+    REQUIRE(movers.size() == 3);
+    REQUIRE(movers.contains(entities[2]));
+
+    int visited = 0;
+    movers.each([&](auto entity, rtype::ecs::component::Position& pos, rtype::ecs::component::Velocity& vel) {
+        REQUIRE(pos.x == vel.vx);
+        REQUIRE(registry.getComponent<rtype::ecs::component::Position>(entity).x == pos.x);
+        ++visited;
+    });
+    REQUIRE(visited == 3);
+}
+
+TEST_CASE("Partial owning group tracks non-owned components", "[Registry]") {
+    GameEngine::Registry registry;
+    auto entity = registry.createEntity();
+    registry.addComponent<rtype::ecs::component::Velocity>(entity, 1.0f, 0.0f);
+
+    auto group = registry.group<rtype::ecs::component::Velocity>(GameEngine::get_t<rtype::ecs::component::Tag>{});
+    REQUIRE(group.size() == 0);
+
+    registry.addComponent<rtype::ecs::component::Tag>(entity, "Enemy");
+    REQUIRE(group.contains(entity));
+    registry.removeComponent<rtype::ecs::component::Tag>(entity);
+    REQUIRE(group.size() == 0);
+
+    REQUIRE_THROWS(registry.group<rtype::ecs::component::Position, rtype::ecs::component::Velocity>());
+}
+
+TEST_CASE("Command buffer defers structural changes until flushed", "[Registry]") {
+    GameEngine::Registry registry;
+    auto& commands = registry.commands();
+
+    auto doomed = registry.createEntity();
+    registry.addComponent<rtype::ecs::component::Position>(doomed, 0.0f, 0.0f);
+
+    GameEngine::entity_t reserved = 0;
+    registry.view<rtype::ecs::component::Position>().each([&](auto entity, rtype::ecs::component::Position&) {
+        commands.destroy(entity);
+        reserved = commands.create();
+        commands.add<rtype::ecs::component::Position>(reserved, 5.0f, 5.0f);
+        commands.add<rtype::ecs::component::Tag>(reserved, "Projectile");
+        commands.add<rtype::ecs::component::Tag>(entity, "Ignored");
+    });
+
+    REQUIRE(registry.isValid(doomed));
+    REQUIRE_FALSE(registry.isValid(reserved));
+    REQUIRE(commands.size() == 5);
+
+    commands.flush();
+    REQUIRE(commands.empty());
+    REQUIRE_FALSE(registry.isValid(doomed));
+    REQUIRE(registry.isValid(reserved));
+
+    int spawned = 0;
+    registry.view<rtype::ecs::component::Position, rtype::ecs::component::Tag>().each(
+        [&](auto, rtype::ecs::component::Position& pos, rtype::ecs::component::Tag& tag) {
+            REQUIRE(pos.x == 5.0f);
+            REQUIRE(tag.name() == "Projectile");
+            ++spawned;
+        });
+    REQUIRE(spawned == 1);
+}
+
+TEST_CASE("Command buffer replays commands queued by listeners during flush", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::Velocity;
+    GameEngine::Registry registry;
+    auto& commands = registry.commands();
+
+    // Each destroyed Position leaves a Velocity-only marker behind, queued from inside flush()
+    std::vector<GameEngine::entity_t> markers;
+    registry.onDestroy<Position>([&markers](GameEngine::Registry& reg, GameEngine::entity_t entity) {
+        auto marker = reg.commands().create();
+        reg.commands().add<Velocity>(marker, reg.getComponent<Position>(entity).x, 0.0f);
+        markers.push_back(marker);
+    });
+    std::size_t constructed = 0;
+    registry.onConstruct<Velocity>([&constructed](GameEngine::Registry& reg, GameEngine::entity_t) {
+        ++constructed;
+        reg.commands().flush(); // Nested, left to the outer flush
+    });
+
+    for (int i = 0; i < 64; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<Position>(entity, static_cast<float>(i), 0.0f);
+        commands.destroy(entity);
+        commands.add<Position>(commands.create(), 100.0f + i, 0.0f);
+    }
+    commands.flush();
+
+    REQUIRE(commands.empty());
+    REQUIRE(markers.size() == 64);
+    REQUIRE(constructed == 64);
+    for (std::size_t i = 0; i < markers.size(); ++i) {
+        REQUIRE(registry.isValid(markers[i]));
+        REQUIRE(registry.getComponent<Velocity>(markers[i]).vx == static_cast<float>(i));
+    }
+    REQUIRE(registry.view<Position>().sizeHint() == 64);
+}
+
+TEST_CASE("SystemManager flushes commands between systems", "[Registry]") {
+    struct Spawner : rtype::ecs::ISystem {
+        void update(GameEngine::Registry& registry, double) override {
+            auto& commands = registry.commands();
+            commands.add<rtype::ecs::component::Position>(commands.create(), 1.0f, 1.0f);
+        }
+    };
+    struct Counter : rtype::ecs::ISystem {
+        explicit Counter(int& seen) : seen(seen) {
+        }
+        void update(GameEngine::Registry& registry, double) override {
+            for (auto entity : registry.view<rtype::ecs::component::Position>()) {
+                (void)entity;
+                ++seen;
+            }
+        }
+        int& seen;
+    };
+
+    GameEngine::Registry registry;
+    GameEngine::SystemManager manager;
+    int seen = 0;
+    manager.addSystem<Spawner>();
+    manager.addSystem<Counter>(seen);
+    manager.update(registry, 0.0);
+
+    REQUIRE(seen == 1);
+    REQUIRE(registry.view<rtype::ecs::component::Position>().sizeHint() == 1);
+}
+
+TEST_CASE("SystemManager stages systems from their declared accesses", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::Tag;
+    using rtype::ecs::component::Velocity;
+    struct Probe : rtype::ecs::ISystem {
+        explicit Probe(void (*declare)(rtype::ecs::SystemAccess&)) : declare(declare) {
+        }
+        void update(GameEngine::Registry&, double) override {
+        }
+        void declareAccess(rtype::ecs::SystemAccess& access) const override {
+            if (declare) {
+                declare(access);
+            }
+        }
+        void (*declare)(rtype::ecs::SystemAccess&);
+    };
+
+    GameEngine::SystemManager manager;
+    manager.addSystem<Probe>([](rtype::ecs::SystemAccess& access) { access.writes<Position>(); });
+    manager.addSystem<Probe>([](rtype::ecs::SystemAccess& access) { access.writes<Velocity>(); });
+    manager.addSystem<Probe>([](rtype::ecs::SystemAccess& access) { access.reads<Position>(); });
+    manager.addSystem<Probe>(nullptr);
+    manager.addSystem<Probe>([](rtype::ecs::SystemAccess& access) { access.reads<Tag>(); });
+
+    const auto& stages = manager.stages();
+    REQUIRE(stages.size() == 4);
+    REQUIRE(stages[0] == std::vector<std::size_t>{0, 1});
+    REQUIRE(stages[1] == std::vector<std::size_t>{2});
+    REQUIRE(stages[2] == std::vector<std::size_t>{3});
+    REQUIRE(stages[3] == std::vector<std::size_t>{4});
+}
+
+TEST_CASE("Parallel SystemManager matches serial execution", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::Tag;
+    using rtype::ecs::component::Velocity;
+    struct Mover : rtype::ecs::ISystem {
+        void update(GameEngine::Registry& registry, double dt) override {
+            registry.view<Position, Velocity>().each([dt](auto, Position& pos, const Velocity& vel) {
+                pos.x += vel.vx * static_cast<float>(dt);
+                pos.y += vel.vy * static_cast<float>(dt);
+            });
+        }
+        void declareAccess(rtype::ecs::SystemAccess& access) const override {
+            access.reads<Velocity>().writes<Position>();
+        }
+    };
+    struct Reaper : rtype::ecs::ISystem {
+        void update(GameEngine::Registry& registry, double) override {
+            auto& commands = registry.commands();
+            registry.view<Tag>().each([&commands](auto entity, Tag& tag) {
+                if (tag.name() == "Doomed") {
+                    commands.destroy(entity);
+                } else {
+                    tag = Tag("Doomed");
+                }
+            });
+        }
+        void declareAccess(rtype::ecs::SystemAccess& access) const override {
+            access.writes<Tag>();
+        }
+    };
+    struct Spawner : rtype::ecs::ISystem {
+        void update(GameEngine::Registry& registry, double) override {
+            auto& commands = registry.commands();
+            auto entity = commands.create();
+            commands.add<Position>(entity, 0.0f, 0.0f);
+            commands.add<Velocity>(entity, 10.0f, 5.0f);
+            commands.add<Tag>(entity, "Fresh");
+        }
+    };
+
+    auto simulate = [](GameEngine::SystemManager::ExecutionMode mode) {
+        GameEngine::Registry registry;
+        GameEngine::SystemManager manager;
+        manager.setExecutionMode(mode);
+        manager.addSystem<Spawner>();
+        manager.addSystem<Mover>();
+        manager.addSystem<Reaper>();
+        for (int tick = 0; tick < 10; ++tick) {
+            manager.update(registry, 0.5);
+        }
+        std::vector<float> xs;
+        registry.view<Position>().each([&xs](auto, const Position& pos) { xs.push_back(pos.x); });
+        return xs;
+    };
+
+    auto serial = simulate(GameEngine::SystemManager::ExecutionMode::Serial);
+    auto parallel = simulate(GameEngine::SystemManager::ExecutionMode::Parallel);
+    REQUIRE_FALSE(serial.empty());
+    REQUIRE(serial == parallel);
+}
+
+TEST_CASE("each_parallel visits every entity once and collects commands", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::Velocity;
+    GameEngine::Registry registry;
+    registry.setThreadCount(4);
+    for (int i = 0; i < 1000; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<Position>(entity, static_cast<float>(i), 0.0f);
+        registry.addComponent<Velocity>(entity, 1.0f, 0.0f);
+    }
+
+    registry.view<Position>().each_parallel(
+        [&registry](auto entity, Position& pos) {
+            pos.y += 1.0f;
+            if (static_cast<int>(pos.x) % 2 == 1) {
+                registry.commands().destroy(entity);
+            }
+        },
+        64);
+    REQUIRE(registry.view<Position>().sizeHint() == 1000);
+    REQUIRE(registry.commands().size() == 500);
+    registry.commands().flush();
+
+    // Reserved from every chunk at once: distinct handles, recycled slots first, valid after the flush
+    std::vector<GameEngine::entity_t> spawned(1000, 0);
+    registry.view<Position>().each_parallel(
+        [&](auto, Position& pos) {
+            auto child = registry.commands().create();
+            registry.commands().add<Velocity>(child, 0.0f, 0.0f);
+            spawned[static_cast<std::size_t>(pos.x)] = child;
+        },
+        16);
+    registry.commands().flush();
+    std::vector<std::size_t> slots;
+    for (std::size_t x = 0; x < spawned.size(); x += 2) {
+        REQUIRE(registry.isValid(spawned[x]));
+        slots.push_back(rtype::ecs::entity::index(spawned[x]));
+    }
+    std::sort(slots.begin(), slots.end());
+    REQUIRE(std::adjacent_find(slots.begin(), slots.end()) == slots.end());
+    REQUIRE(slots.back() < 1000);
+    for (auto child : spawned) {
+        if (child != 0) {
+            registry.destroyEntity(child);
+        }
+    }
+
+    auto movers = registry.group<Position, Velocity>();
+    movers.each_parallel([](auto, Position& pos, const Velocity& vel) { pos.y += vel.vx; }, 32);
+
+    std::size_t count = 0;
+    registry.view<Position>().each([&count](auto, const Position& pos) {
+        REQUIRE(static_cast<int>(pos.x) % 2 == 0);
+        REQUIRE(pos.y == 2.0f);
+        ++count;
+    });
+    REQUIRE(count == 500);
+}
+
+TEST_CASE("SystemManager records per-system timings", "[Registry]") {
+    using rtype::ecs::component::Position;
+    struct Walker : rtype::ecs::ISystem {
+        void update(GameEngine::Registry& registry, double) override {
+            registry.view<Position>().each([](auto, Position& pos) { pos.x += 1.0f; });
+        }
+    };
+
+    GameEngine::Registry registry;
+    for (int i = 0; i < 10; ++i) {
+        registry.addComponent<Position>(registry.createEntity(), 0.0f, 0.0f);
+    }
+    GameEngine::SystemManager manager;
+    manager.addSystem<Walker>();
+    for (int tick = 0; tick < 300; ++tick) {
+        manager.update(registry, 0.0);
+    }
+
+    auto timings = manager.timings();
+    if constexpr (GameEngine::SystemProfiler::Enabled) {
+        REQUIRE(timings.size() == 1);
+        REQUIRE(timings[0].name == "Walker");
+        REQUIRE(timings[0].samples == GameEngine::SystemProfiler::Capacity);
+        REQUIRE(timings[0].entities == 10);
+        REQUIRE(timings[0].p50Ms <= timings[0].p95Ms);
+        REQUIRE(timings[0].p95Ms <= timings[0].p99Ms);
+        REQUIRE(timings[0].p99Ms <= timings[0].maxMs);
+    } else {
+        REQUIRE(timings.empty());
+    }
+}
+
+TEST_CASE("Registry tracks component changes per tick", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::Velocity;
+    GameEngine::Registry registry;
+    auto still = registry.createEntity();
+    auto moving = registry.createEntity();
+    registry.addComponent<Position>(still, 0.0f, 0.0f);
+    registry.addComponent<Position>(moving, 0.0f, 0.0f);
+    registry.addComponent<Velocity>(moving, 1.0f, 0.0f);
+
+    const std::uint32_t since = registry.advanceChangeTick();
+    REQUIRE(registry.changedSince<Position>(still, 0));
+    REQUIRE_FALSE(registry.changedSince<Position>(still, since));
+
+    registry.patch<Position>(moving).x = 5.0f;
+    registry.markChanged<Velocity>(still);
+    REQUIRE(registry.changedSince<Position>(moving, since));
+    REQUIRE_FALSE(registry.changedSince<Velocity>(moving, since));
+
+    std::vector<GameEngine::entity_t> changed;
+    registry.eachChanged<Position>(since, [&changed](auto entity, Position& pos) {
+        REQUIRE(pos.x == 5.0f);
+        changed.push_back(entity);
+    });
+    REQUIRE(changed == std::vector<GameEngine::entity_t>{moving});
+
+    // Versions follow components when slots are swapped by removals and groups
+    registry.removeComponent<Position>(still);
+    auto movers = registry.group<Position, Velocity>();
+    REQUIRE(movers.size() == 1);
+    REQUIRE(registry.changedSince<Position>(moving, since));
+    REQUIRE_FALSE(registry.changedSince<Position>(moving, registry.advanceChangeTick()));
+}
+
+TEST_CASE("Registry signals component construction and destruction", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::Velocity;
+    GameEngine::Registry registry;
+    std::vector<GameEngine::entity_t> constructed;
+    std::vector<float> destroyedX;
+    auto onAdd = registry.onConstruct<Position>([&constructed](GameEngine::Registry&, GameEngine::entity_t entity) {
+        constructed.push_back(entity);
+    });
+    registry.onDestroy<Position>([&destroyedX](GameEngine::Registry& reg, GameEngine::entity_t entity) {
+        destroyedX.push_back(reg.getComponent<Position>(entity).x);
+    });
+
+    auto first = registry.createEntity();
+    auto second = registry.createEntity();
+    auto third = registry.createEntity();
+    registry.addComponent<Position>(first, 1.0f, 0.0f);
+    registry.addComponent<Position>(first, 2.0f, 0.0f);
+    registry.addComponent<Velocity>(first, 0.0f, 0.0f);
+    registry.addComponent<Position>(second, 3.0f, 0.0f);
+    registry.addComponent<Position>(third, 4.0f, 0.0f);
+    REQUIRE(constructed == std::vector<GameEngine::entity_t>{first, second, third});
+
+    registry.removeComponent<Velocity>(first);
+    registry.removeComponent<Position>(first);
+    registry.destroyEntity(second);
+    registry.clear();
+    REQUIRE(destroyedX == std::vector<float>{2.0f, 3.0f, 4.0f});
+
+    registry.disconnect(onAdd);
+    registry.addComponent<Position>(registry.createEntity(), 0.0f, 0.0f);
+    REQUIRE(constructed.size() == 3);
+}
+
+TEST_CASE("Registry snapshot round-trips entities and components", "[Registry]") {
+    using namespace rtype::ecs::component;
+    GameEngine::Registry registry;
+    rtype::ecs::registerGameplaySnapshots(registry);
+
+    auto dead = registry.createEntity();
+    auto player = registry.createEntity();
+    auto enemy = registry.createEntity();
+    registry.destroyEntity(dead);
+    registry.addComponent<Position>(player, 10.0f, 20.0f);
+    registry.addComponent<Tag>(player, "Player");
+    registry.addComponent<Weapon>(player).projectileTag = rtype::ecs::TagTable::intern("ChargedProjectile");
+    registry.addComponent<Position>(enemy, 30.0f, 40.0f);
+    registry.addComponent<Health>(enemy, 5, 10);
+
+    std::vector<std::uint8_t> blob;
+    registry.snapshot(blob);
+
+    registry.getComponent<Position>(player).x = 99.0f;
+    registry.removeComponent<Tag>(player);
+    auto extra = registry.createEntity();
+    registry.addComponent<Position>(extra, 0.0f, 0.0f);
+
+    registry.restore(blob);
+
+    REQUIRE(registry.isValid(player));
+    REQUIRE(registry.isValid(enemy));
+    REQUIRE_FALSE(registry.isValid(dead));
+    REQUIRE_FALSE(registry.isValid(extra));
+    REQUIRE(registry.getComponent<Position>(player).x == 10.0f);
+    REQUIRE(registry.getComponent<Tag>(player).id == rtype::ecs::tags::Player);
+    REQUIRE(rtype::ecs::TagTable::name(registry.getComponent<Weapon>(player).projectileTag) == "ChargedProjectile");
+    REQUIRE(registry.getComponent<Position>(enemy).y == 40.0f);
+    REQUIRE(registry.getComponent<Health>(enemy).hp == 5);
+    REQUIRE_FALSE(registry.hasComponent<Health>(player));
+
+    // Freed slots are recycled with a new generation, as before the snapshot
+    auto recycled = registry.createEntity();
+    REQUIRE(recycled != dead);
+    REQUIRE(rtype::ecs::entity::index(recycled) == rtype::ecs::entity::index(dead));
+
+    blob.resize(blob.size() / 2);
+    REQUIRE_THROWS(registry.restore(blob));
+    REQUIRE_FALSE(registry.isValid(player));
+}
+
+TEST_CASE("Tags are interned once and map to network spawn types", "[Tag]") {
+    using rtype::ecs::TagTable;
+    namespace tags = rtype::ecs::tags;
+
+    REQUIRE(TagTable::intern("Player") == tags::Player);
+    REQUIRE(TagTable::name(tags::ShotDeathCharge3) == "shot_death-charge3");
+
+    const rtype::ecs::TagId custom = TagTable::intern("Test_Custom_Tag");
+    REQUIRE(custom >= tags::Known.size());
+    REQUIRE(TagTable::intern(std::string("Test_Custom_Tag")) == custom);
+    REQUIRE(TagTable::find("Test_Custom_Tag") == custom);
+    REQUIRE_FALSE(TagTable::find("Test_Never_Interned").has_value());
+    REQUIRE(rtype::ecs::component::Tag("Test_Custom_Tag").name() == "Test_Custom_Tag");
+
+    REQUIRE(tags::isChargeShot(tags::ShotDeathCharge1));
+    REQUIRE_FALSE(tags::isChargeShot(tags::Shot));
+    REQUIRE(tags::isPlayerShot(tags::Shot));
+
+    const auto boss = tags::spawnTypeOf(tags::Boss2, false);
+    REQUIRE(boss.entityType == rtype::net::EntityType::ENEMY);
+    REQUIRE(boss.subType == 101);
+    REQUIRE(tags::tagOfSpawn(boss.entityType, boss.subType) == tags::Boss2);
+    REQUIRE(tags::spawnTypeOf(tags::ObstacleTrain4, false).entityType == rtype::net::EntityType::OBSTACLE);
+    REQUIRE(tags::spawnTypeOf(tags::Monster0Top, true).subType == 0);
+    REQUIRE(tags::spawnTypeOf(tags::Laser, false).entityType == rtype::net::EntityType::PROJECTILE);
+    REQUIRE(tags::spawnTypeOf(custom, false).subType == 0);
+}
+
+TEST_CASE("Registry context holds one value per type outside entities", "[Registry]") {
+    using namespace rtype::ecs::component;
+    GameEngine::Registry registry;
+    rtype::ecs::registerGameplaySnapshots(registry);
+
+    REQUIRE(registry.findContext<MapBounds>() == nullptr);
+    REQUIRE_THROWS(registry.context<MapBounds>());
+
+    registry.emplaceContext<MapBounds>(0.0f, 0.0f, 800.0f, 600.0f);
+    registry.emplaceContext<EnemySpawner>(2.0f, 0.0f).currentWave = 3;
+    REQUIRE(registry.hasContext<MapBounds>());
+    REQUIRE(registry.context<EnemySpawner>().currentWave == 3);
+    REQUIRE(registry.view<MapBounds>().empty());
+
+    registry.emplaceContext<MapBounds>(0.0f, 0.0f, 1920.0f, 1080.0f);
+    registry.clear();
+    REQUIRE(registry.context<MapBounds>().maxX == 1920.0f);
+
+    std::vector<std::uint8_t> blob;
+    registry.snapshot(blob);
+    registry.context<EnemySpawner>().currentWave = 0;
+    registry.eraseContext<MapBounds>();
+    registry.restore(blob);
+
+    REQUIRE(registry.context<MapBounds>().maxY == 1080.0f);
+    REQUIRE(registry.context<EnemySpawner>().currentWave == 3);
+    REQUIRE_FALSE(registry.hasContext<GameRulesComponent>());
+}
+
+TEST_CASE("Empty components are stored as membership only", "[Registry]") {
+    using namespace rtype::ecs::component;
+    STATIC_REQUIRE(rtype::ecs::SparseSet<UITag>::membership_only);
+    STATIC_REQUIRE_FALSE(rtype::ecs::SparseSet<Position>::membership_only);
+
+    GameEngine::Registry registry;
+    rtype::ecs::registerGameplaySnapshots(registry);
+    std::vector<GameEngine::entity_t> entities;
+    for (int i = 0; i < 6; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<Position>(entity, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0) {
+            registry.addComponent<UITag>(entity);
+            registry.addComponent<ScreenMode>(entity);
+        }
+        entities.push_back(entity);
+    }
+    registry.removeComponent<UITag>(entities[2]);
+    registry.destroyEntity(entities[4]);
+
+    REQUIRE(registry.hasComponent<UITag>(entities[0]));
+    REQUIRE_FALSE(registry.hasComponent<UITag>(entities[1]));
+    REQUIRE_FALSE(registry.hasComponent<UITag>(entities[2]));
+
+    int visited = 0;
+    registry.view<Position, UITag>().each([&](auto entity, Position& pos) {
+        REQUIRE(entity == entities[0]);
+        REQUIRE(pos.x == 0.0f);
+        ++visited;
+    });
+    REQUIRE(visited == 1);
+
+    auto tagged = registry.group<Position>(GameEngine::get_t<ScreenMode>{});
+    REQUIRE(tagged.size() == 2);
+    visited = 0;
+    tagged.each([&](auto, Position&) { ++visited; });
+    REQUIRE(visited == 2);
+
+    std::vector<std::uint8_t> blob;
+    registry.snapshot(blob);
+    registry.removeComponent<ScreenMode>(entities[0]);
+    registry.restore(blob);
+    REQUIRE(registry.hasComponent<ScreenMode>(entities[0]));
+    REQUIRE(registry.hasComponent<ScreenMode>(entities[2]));
+    REQUIRE_FALSE(registry.hasComponent<ScreenMode>(entities[1]));
+}
+
+TEST_CASE("Persistent queries track matches incrementally and count their cost", "[Registry]") {
+    using rtype::ecs::component::Position;
+    using rtype::ecs::component::UITag;
+    using rtype::ecs::component::Velocity;
+
+    GameEngine::Registry registry;
+    std::vector<GameEngine::entity_t> entities;
+    for (int i = 0; i < 4; ++i) {
+        auto entity = registry.createEntity();
+        registry.addComponent<Position>(entity, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0) {
+            registry.addComponent<Velocity>(entity, 1.0f, 0.0f);
+        }
+        entities.push_back(entity);
+    }
+
+    auto movers = registry.query<Position, Velocity>("movers");
+    REQUIRE(movers.size() == 2);
+    REQUIRE(movers.contains(entities[0]));
+    REQUIRE_FALSE(movers.contains(entities[1]));
+
+    registry.addComponent<Velocity>(entities[1], 2.0f, 0.0f);
+    registry.removeComponent<Velocity>(entities[0]);
+    registry.destroyEntity(entities[2]);
+    REQUIRE(movers.size() == 1);
+    REQUIRE(movers.contains(entities[1]));
+    REQUIRE(registry.query<Position, Velocity>().contains(entities[1]));
+
+    movers.each([&](auto entity, Position& pos, Velocity& vel) {
+        REQUIRE(entity == entities[1]);
+        REQUIRE(pos.x == 1.0f);
+        REQUIRE(vel.vx == 2.0f);
+        registry.removeComponent<Velocity>(entity);
+    });
+    REQUIRE(movers.empty());
+
+    auto tagged = registry.query<Position, UITag>();
+    registry.addComponent<UITag>(entities[3]);
+    int visited = 0;
+    tagged.each([&](auto, Position&) { ++visited; });
+    for (auto entity : tagged) {
+        REQUIRE(tagged.get<Position>(entity).x == 3.0f);
+        ++visited;
+    }
+    REQUIRE(visited == 2);
+
+    registry.clear();
+    REQUIRE(tagged.empty());
+
+    const auto stats = registry.queryStats();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].name == "movers");
+    REQUIRE(stats[0].size == 0);
+    REQUIRE(stats[0].runs == 1);
+    REQUIRE(stats[0].visited == 1);
+    REQUIRE(stats[0].updates == 6);
+    REQUIRE(stats[1].runs == 2);
+    REQUIRE(stats[1].visited == 2);
+    REQUIRE(stats[1].updates == 1);
+
+    // Query slots are shared by every registry, each still gets its own query
+    GameEngine::Registry other;
+    other.addComponent<Velocity>(other.createEntity(), 0.0f, 0.0f);
+    auto otherMovers = other.query<Position, Velocity>();
+    REQUIRE(otherMovers.empty());
+    REQUIRE(other.queryStats().size() == 1);
+    REQUIRE(registry.queryStats().size() == 2);
+}
+
+TEST_CASE("Drawables share animation clips and interned textures", "[Drawable]") {
+    using rtype::ecs::AnimationClips;
+    using rtype::ecs::TextureTable;
+    namespace clips = rtype::ecs::clips;
+
+    REQUIRE(AnimationClips::get(clips::Explosion).frames == std::vector<std::uint32_t>{5, 4, 3, 2, 1, 0});
+    REQUIRE(AnimationClips::find("ship_up") == clips::ShipUp);
+    REQUIRE(AnimationClips::get(clips::None).frames.empty());
+
+    const rtype::ecs::ClipId custom = AnimationClips::define("test_blink", {0, 1});
+    REQUIRE(custom > clips::Explosion);
+    REQUIRE(AnimationClips::define("test_blink", {7}) == custom);
+    REQUIRE(AnimationClips::get(custom).frames.size() == 2);
+    REQUIRE(AnimationClips::get(60000).name.empty());
+
+    rtype::ecs::component::Drawable drawable("explosion", 5, 0, 37, 44);
+    REQUIRE(drawable.texture == TextureTable::intern("explosion"));
+    REQUIRE(drawable.texture_name() == "explosion");
+    REQUIRE(rtype::ecs::component::Drawable().texture_name().empty());
+    REQUIRE(TextureTable::name(60000).empty());
+    drawable.clip = clips::Explosion;
+    const auto copy = drawable;
+    REQUIRE(copy.clip == clips::Explosion);
+    REQUIRE(copy.texture == drawable.texture);
+}
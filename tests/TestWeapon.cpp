@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Registry.hpp"
+#include "CommandBuffer.hpp"
 #include "components/Position.hpp"
 #include "components/Weapon.hpp"
 #include "components/Projectile.hpp"
@@ -17,6 +18,7 @@ TEST_CASE("WeaponSystem spawns projectiles", "[WeaponSystem]") {
     weapon.fireRate = 0.5f;
 
     weaponSystem.update(registry, 0.1);
+    registry.commands().flush();
 
     bool projectileFound = false;
     auto view = registry.view<rtype::ecs::component::Projectile>();
@@ -42,6 +44,7 @@ TEST_CASE("WeaponSystem respects fire rate", "[WeaponSystem]") {
     weapon.fireRate = 0.5f;
 
     weaponSystem.update(registry, 0.1);
+    registry.commands().flush();
 
     bool projectileFound = false;
     auto view = registry.view<rtype::ecs::component::Projectile>();